@@ -0,0 +1,164 @@
+#include "AudioAnalyser.h"
+#include <cmath>
+
+namespace
+{
+    // How much output the FIFO holds before the audio side starts dropping
+    constexpr double fifoSeconds = 0.25;
+
+    constexpr float lowestBandHz = 30.0f;
+    constexpr float spectrumFloorDb = -72.0f;
+
+    inline float smoothValue(float current, float target, float attack, float release) noexcept
+    {
+        const float coeff = target > current ? attack : release;
+        return current + (target - current) * coeff;
+    }
+}
+
+AudioAnalyser::AudioAnalyser()
+    : juce::Thread("Audio analysis")
+{
+    // Hann window, plus the FFT buffer sized once up front
+    for (int i = 0; i < fftSize; ++i)
+        window[(size_t)i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)fftSize);
+
+    fftData.resize((size_t)fftSize);
+}
+
+AudioAnalyser::~AudioAnalyser()
+{
+    stop();
+}
+
+void AudioAnalyser::start(double sampleRate)
+{
+    stop();
+
+    fifo.prepare((int)std::ceil(sampleRate * fifoSeconds));
+    drained.assign((size_t)fifo.getCapacity(), 0.0f);
+    glitchActive.store(false);
+
+    history.fill(0.0f);
+    historyWrite = 0;
+    lowState = midState = 0.0f;
+    smoothed = Frame();
+
+    // Log-spaced band edges in FFT bins; every band covers at least one bin
+    const float nyquist = (float)sampleRate * 0.5f;
+    const float binHz = (float)sampleRate / (float)fftSize;
+    const float lowest = juce::jmin(lowestBandHz, nyquist * 0.5f);
+
+    for (int b = 0; b <= numSpectrumBands; ++b)
+    {
+        const float hz = lowest * std::pow(nyquist / lowest, (float)b / (float)numSpectrumBands);
+        bandEdges[(size_t)b] = juce::jlimit(1, fftSize / 2, juce::roundToInt(hz / binHz));
+    }
+
+    startThread(juce::Thread::Priority::low);
+}
+
+void AudioAnalyser::stop()
+{
+    stopThread(1000);
+}
+
+bool AudioAnalyser::getLatestFrame(Frame& frame) noexcept
+{
+    if (!frames.acquire())
+        return false;
+
+    frame = frames.getReadBuffer();
+    return true;
+}
+
+//==============================================================================
+void AudioAnalyser::run()
+{
+    while (!threadShouldExit())
+    {
+        const int numSamples = fifo.pop(drained.data(), (int)drained.size());
+
+        if (numSamples > 0)
+            analyse(numSamples);
+
+        wait(analysisIntervalMs);
+    }
+}
+
+void AudioAnalyser::analyse(int numSamples) noexcept
+{
+    float peak = 0.0f;
+    float sumSquares = 0.0f;
+    float lowAccum = 0.0f;
+    float midAccum = 0.0f;
+    float highAccum = 0.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float mono = drained[(size_t)i];
+        peak = juce::jmax(peak, std::abs(mono));
+        sumSquares += mono * mono;
+
+        // Two one-pole splits: low, mid, and what's left above them
+        lowState += 0.04f * (mono - lowState);
+        const float highPass = mono - lowState;
+        midState += 0.08f * (highPass - midState);
+        const float highComponent = highPass - midState;
+
+        lowAccum += std::abs(lowState);
+        midAccum += std::abs(midState);
+        highAccum += std::abs(highComponent);
+
+        history[(size_t)historyWrite] = mono;
+        historyWrite = (historyWrite + 1) & (fftSize - 1);
+    }
+
+    const float invSamples = 1.0f / (float)numSamples;
+    const float rms = std::sqrt(sumSquares * invSamples);
+    const float glitch = glitchActive.exchange(false, std::memory_order_relaxed) ? 1.0f : 0.0f;
+
+    smoothed.peak = smoothValue(smoothed.peak, juce::jlimit(0.0f, 1.2f, peak), 0.45f, 0.08f);
+    smoothed.rms = smoothValue(smoothed.rms, juce::jlimit(0.0f, 1.2f, rms), 0.3f, 0.08f);
+    smoothed.lowBand = smoothValue(smoothed.lowBand, juce::jlimit(0.0f, 1.5f, lowAccum * invSamples), 0.3f, 0.05f);
+    smoothed.midBand = smoothValue(smoothed.midBand, juce::jlimit(0.0f, 1.5f, midAccum * invSamples), 0.25f, 0.05f);
+    smoothed.highBand = smoothValue(smoothed.highBand, juce::jlimit(0.0f, 1.5f, highAccum * invSamples), 0.2f, 0.04f);
+    smoothed.glitch = smoothValue(smoothed.glitch, glitch, 0.35f, 0.08f);
+
+    std::array<float, numSpectrumBands> bands;
+    computeSpectrum(bands);
+
+    for (size_t b = 0; b < bands.size(); ++b)
+        smoothed.spectrum[b] = smoothValue(smoothed.spectrum[b], bands[b], 0.5f, 0.15f);
+
+    frames.getWriteBuffer() = smoothed;
+    frames.publish();
+}
+
+void AudioAnalyser::computeSpectrum(std::array<float, numSpectrumBands>& bands) noexcept
+{
+    // Oldest sample first, so the window lines up with the history
+    for (int i = 0; i < fftSize; ++i)
+    {
+        const float sample = history[(size_t)((historyWrite + i) & (fftSize - 1))];
+        fftData[(size_t)i] = { sample * window[(size_t)i], 0.0f };
+    }
+
+    fft.perform(fftData.data(), false);
+
+    // Sine amplitude: |X| * 2 / sum(window), and the Hann window sums to N / 2
+    const float amplitudeScale = 4.0f / (float)fftSize;
+
+    for (int b = 0; b < numSpectrumBands; ++b)
+    {
+        const int firstBin = bandEdges[(size_t)b];
+        const int endBin = juce::jmax(firstBin + 1, bandEdges[(size_t)b + 1]);
+
+        float strongest = 0.0f;
+        for (int bin = firstBin; bin < endBin && bin <= fftSize / 2; ++bin)
+            strongest = juce::jmax(strongest, std::abs(fftData[(size_t)bin]));
+
+        const float db = juce::Decibels::gainToDecibels(strongest * amplitudeScale, spectrumFloorDb);
+        bands[(size_t)b] = juce::jlimit(0.0f, 1.0f, 1.0f - db / spectrumFloorDb);
+    }
+}
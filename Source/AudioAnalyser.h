@@ -0,0 +1,80 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <complex>
+#include <vector>
+#include "SimpleFft.h"
+#include "SpscRingBuffer.h"
+#include "TripleBuffer.h"
+
+// Output metering and spectrum for the visualiser, computed off the audio
+// thread.
+//
+// The audio callback only pushes its mono output into a lock-free FIFO.
+// A low-priority thread drains it a few dozen times a second, runs the
+// band split, peak / RMS and an FFT over the newest samples, smooths the
+// results and publishes them as a Frame through a triple buffer, which the
+// message thread picks up on its timer.
+class AudioAnalyser : private juce::Thread
+{
+public:
+    static constexpr int fftOrder = 10;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numSpectrumBands = 48;
+
+    struct Frame
+    {
+        float peak = 0.0f;
+        float rms = 0.0f;
+        float lowBand = 0.0f;
+        float midBand = 0.0f;
+        float highBand = 0.0f;
+        float glitch = 0.0f;
+
+        // 0..1 per band, log-spaced from 30 Hz to Nyquist (-72 dB .. 0 dB)
+        std::array<float, numSpectrumBands> spectrum {};
+    };
+
+    AudioAnalyser();
+    ~AudioAnalyser() override;
+
+    // Not real-time safe: (re)starts the analysis thread for a sample rate.
+    void start(double sampleRate);
+    void stop();
+
+    // ===== Audio thread =====
+    // Samples that don't fit (the analysis thread has stalled) are dropped.
+    void pushSamples(const float* samples, int numSamples) noexcept    { fifo.push(samples, numSamples); }
+    void noteGlitchActivity() noexcept                                  { glitchActive.store(true, std::memory_order_relaxed); }
+
+    // ===== Message thread =====
+    // Returns true and fills frame if a newer analysis has been published.
+    bool getLatestFrame(Frame& frame) noexcept;
+
+private:
+    static constexpr int analysisIntervalMs = 16;
+
+    SpscRingBuffer<float> fifo;
+    std::atomic<bool> glitchActive { false };
+    TripleBuffer<Frame> frames;
+
+    // Analysis thread state
+    SimpleFft fft { fftOrder };
+    std::vector<float> drained;
+    std::array<float, fftSize> history {};       // newest fftSize samples, circular
+    int historyWrite = 0;
+    std::array<float, fftSize> window {};
+    std::vector<std::complex<float>> fftData;
+    std::array<int, numSpectrumBands + 1> bandEdges {};
+
+    float lowState = 0.0f;
+    float midState = 0.0f;
+    Frame smoothed;
+
+    void run() override;
+    void analyse(int numSamples) noexcept;
+    void computeSpectrum(std::array<float, numSpectrumBands>& bands) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioAnalyser)
+};
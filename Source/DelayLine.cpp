@@ -0,0 +1,131 @@
+#include "DelayLine.h"
+#include <cmath>
+#include <cstring>
+
+void DelayLine::prepare(int maxDelaySamples, int newNumChannels)
+{
+    numChannels = juce::jlimit(1, maxChannels, newNumChannels);
+    size = juce::nextPowerOfTwo(juce::jmax(1, maxDelaySamples) + interpolationMargin + 1);
+    jassert(getMaxDelaySamples() >= maxDelaySamples);
+    mask = size - 1;
+    buffer.assign((size_t)(numChannels * size), 0.0f);
+    reset();
+}
+
+void DelayLine::reset() noexcept
+{
+    std::fill(buffer.begin(), buffer.end(), 0.0f);
+    writePosition = 0;
+
+    for (auto& channel : allpassState)
+        for (auto& state : channel)
+            state = 0.0f;
+}
+
+//==============================================================================
+void DelayLine::copyOut(const float* ring, int start, float* output, int numSamples) const noexcept
+{
+    const int first = juce::jmin(numSamples, size - start);
+    std::memcpy(output, ring + start, (size_t)first * sizeof(float));
+    if (first < numSamples)
+        std::memcpy(output + first, ring, (size_t)(numSamples - first) * sizeof(float));
+}
+
+// newest: ring index of the sample this output lines up with (delay 0).
+inline float DelayLine::interpolate(const float* ring, int newest, float delay, float& allpass) const noexcept
+{
+    const int whole = (int)delay;
+    const float frac = delay - (float)whole;
+    const int index = newest - whole;
+
+    switch (interpolation)
+    {
+        case linearInterpolation:
+        {
+            const float a = ring[index & mask];
+            const float b = ring[(index - 1) & mask];
+            return a + frac * (b - a);
+        }
+
+        case allpassInterpolation:
+        {
+            // First-order Thiran allpass: flat magnitude, but it carries state,
+            // so it suits slowly moving delays best. The fraction is kept in
+            // [0.618, 1.618) where the allpass's own delay is well behaved.
+            const bool shift = frac < 0.618f;
+            const float d = shift ? frac + 1.0f : frac;
+            const int newer = shift ? index + 1 : index;
+            const float a = ring[newer & mask];
+            const float b = ring[(newer - 1) & mask];
+            const float alpha = (1.0f - d) / (1.0f + d);
+            allpass = b + alpha * (a - allpass);
+            return allpass;
+        }
+
+        case lagrangeInterpolation:
+        default:
+        {
+            // Third-order Lagrange through the samples at delays whole - 1 ..
+            // whole + 2, evaluated at t = frac + 1.
+            const float t = frac + 1.0f;
+            const float x0 = ring[(index + 1) & mask];
+            const float x1 = ring[index & mask];
+            const float x2 = ring[(index - 1) & mask];
+            const float x3 = ring[(index - 2) & mask];
+
+            const float d1 = t - 1.0f;
+            const float d2 = t - 2.0f;
+            const float d3 = t - 3.0f;
+            return -d1 * d2 * d3 * (1.0f / 6.0f) * x0
+                 + t * (d2 * d3 * 0.5f * x1 - d1 * d3 * 0.5f * x2 + d1 * d2 * (1.0f / 6.0f) * x3);
+        }
+    }
+}
+
+void DelayLine::read(int channel, int tap, float delaySamples, float* output, int numSamples) noexcept
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels) && juce::isPositiveAndBelow(tap, maxTaps));
+
+    const float* ring = channelData(channel);
+    const float delay = juce::jlimit(getMinDelaySamples(numSamples), (float)getMaxDelaySamples(), delaySamples);
+    const int whole = (int)delay;
+
+    if ((float)whole == delay && interpolation != allpassInterpolation)
+    {
+        copyOut(ring, (writePosition - whole) & mask, output, numSamples);
+        return;
+    }
+
+    float& allpass = allpassState[channel][tap];
+    for (int i = 0; i < numSamples; ++i)
+        output[i] = interpolate(ring, writePosition + i, delay, allpass);
+}
+
+void DelayLine::read(int channel, int tap, const float* delaySamples, float* output, int numSamples) noexcept
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels) && juce::isPositiveAndBelow(tap, maxTaps));
+
+    const float* ring = channelData(channel);
+    const float minDelay = getMinDelaySamples(numSamples);
+    const float maxDelay = (float)getMaxDelaySamples();
+    float& allpass = allpassState[channel][tap];
+
+    for (int i = 0; i < numSamples; ++i)
+        output[i] = interpolate(ring, writePosition + i, juce::jlimit(minDelay, maxDelay, delaySamples[i]), allpass);
+}
+
+void DelayLine::write(int channel, const float* input, int numSamples) noexcept
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels) && numSamples <= size);
+
+    float* ring = channelData(channel);
+    const int first = juce::jmin(numSamples, size - writePosition);
+    std::memcpy(ring + writePosition, input, (size_t)first * sizeof(float));
+    if (first < numSamples)
+        std::memcpy(ring, input + first, (size_t)(numSamples - first) * sizeof(float));
+}
+
+void DelayLine::advance(int numSamples) noexcept
+{
+    writePosition = (writePosition + numSamples) & mask;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// Multi-channel ring buffer for block-wise delay effects.
+//
+// The ring is a power of two long, so every index wraps with a mask instead
+// of a modulo. A block is processed as read-then-write: read() pulls
+// numSamples of delayed signal for each tap, the caller mixes its feedback,
+// write() appends the block, and advance() moves the write head. Because a
+// read never reaches into the block being written, delays shorter than the
+// block (plus the interpolator's look-ahead) are lengthened to fit.
+//
+// Writes, and reads at a constant whole-sample delay, are at most two
+// contiguous copies. Reads with a fractional or per-sample delay go through
+// the selected interpolator.
+class DelayLine
+{
+public:
+    enum Interpolation { linearInterpolation = 0, lagrangeInterpolation, allpassInterpolation };
+
+    static constexpr int maxChannels = 2;
+    static constexpr int maxTaps = 4;
+
+    DelayLine() = default;
+
+    // Not real-time safe: sizes the ring for at least maxDelaySamples.
+    void prepare(int maxDelaySamples, int numChannels);
+    void reset() noexcept;
+
+    void setInterpolation(Interpolation newInterpolation) noexcept { interpolation = newInterpolation; }
+    Interpolation getInterpolation() const noexcept { return interpolation; }
+
+    // Longest delay a read can ask for.
+    int getMaxDelaySamples() const noexcept { return juce::jmax(0, size - interpolationMargin - 1); }
+
+    // Shortest delay a read of numSamples can ask for.
+    static float getMinDelaySamples(int numSamples) noexcept { return (float)(numSamples + interpolationMargin); }
+
+    // tap picks the allpass state, so each tap of a channel keeps its own.
+    void read(int channel, int tap, float delaySamples, float* output, int numSamples) noexcept;
+    void read(int channel, int tap, const float* delaySamples, float* output, int numSamples) noexcept;
+
+    void write(int channel, const float* input, int numSamples) noexcept;
+    void advance(int numSamples) noexcept;
+
+private:
+    // Samples either side of the read point the interpolators touch
+    static constexpr int interpolationMargin = 2;
+
+    std::vector<float> buffer;
+    int size = 0;
+    int mask = 0;
+    int numChannels = 0;
+    int writePosition = 0;
+    Interpolation interpolation = lagrangeInterpolation;
+    float allpassState[maxChannels][maxTaps] {};
+
+    float* channelData(int channel) noexcept { return buffer.data() + (size_t)channel * (size_t)size; }
+    void copyOut(const float* ring, int start, float* output, int numSamples) const noexcept;
+
+    inline float interpolate(const float* ring, int newest, float delay, float& allpass) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DelayLine)
+};
@@ -0,0 +1,125 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Compile-time selectable maths for the DSP hot path.
+//
+// Precise forwards to <cmath>; Fast uses cheap approximations. Both expose the
+// same static functions, so code is written once against DspMath and the
+// policy is picked by SYNTH_FAST_MATH (default on; build with
+// SYNTH_FAST_MATH=0 for offline/bounce builds that want libm accuracy).
+//
+// Max error of Fast against double-precision libm (2M-point sweeps):
+//   tanh : 2.1e-7 for |x| < 2, 1.0e-4 worst case (just below the |x| = 4.97 clamp)
+//   sin  : 2.2e-7 for |x| <= 10; range reduction is in float, so it grows with
+//          |x| (7.6e-4 at 1e4) - callers here always pass wrapped phases
+//   exp2 : 8.4e-6 relative over [-126, 126]
+//   log2 : 5.8e-7 absolute over [1e-6, 1000]
+// On x86-64 (gcc -O2, glibc) a mixed tanh/sin/exp2 loop over shuffled inputs
+// runs about 2.5-3x faster with Fast; nearly all of that is tanh and sin, as
+// glibc's own exp2f/log2f are already about as quick as these.
+// Tools/FastMathBench reproduces both the error sweeps and the timing.
+namespace dspmath
+{
+    struct Precise
+    {
+        static inline float tanh(float x) noexcept  { return std::tanh(x); }
+        static inline float sin(float x) noexcept   { return std::sin(x); }
+        static inline float cos(float x) noexcept   { return std::cos(x); }
+        static inline float exp2(float x) noexcept  { return std::exp2(x); }
+        static inline float log2(float x) noexcept  { return std::log2(x); }
+    };
+
+    struct Fast
+    {
+        // [7/6] Lambert continued-fraction approximant; reaches 1 at |x| = 4.97.
+        static inline float tanh(float x) noexcept
+        {
+            x = juce::jlimit(-4.97f, 4.97f, x);
+            const float x2 = x * x;
+            const float num = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+            const float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+            return num / den;
+        }
+
+        // Reduce by whole half-turns to [-pi/2, pi/2], then an odd 11th order
+        // polynomial; an odd number of half-turns flips the sign bit. There is
+        // no data-dependent branch, so random phases cost the same as sorted ones.
+        static inline float sin(float x) noexcept
+        {
+            constexpr float invPi = 1.0f / juce::MathConstants<float>::pi;
+            constexpr float pi = juce::MathConstants<float>::pi;
+
+            const float halfTurns = x * invPi;
+            const std::int32_t k = (std::int32_t)(halfTurns + std::copysign(0.5f, halfTurns));
+            x -= pi * (float)k;
+
+            const float x2 = x * x;
+            const float y = x * (1.0f + x2 * (-1.6666667e-1f + x2 * (8.3333333e-3f + x2 * (-1.9841270e-4f
+                          + x2 * (2.7557319e-6f + x2 * -2.5052108e-8f)))));
+
+            std::uint32_t bits;
+            std::memcpy(&bits, &y, sizeof(bits));
+            bits ^= (std::uint32_t)(k & 1) << 31;
+
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        static inline float cos(float x) noexcept
+        {
+            return sin(x + juce::MathConstants<float>::halfPi);
+        }
+
+        // 2^x = 2^floor(x) * 2^frac; the fraction uses a degree-6 polynomial.
+        static inline float exp2(float x) noexcept
+        {
+            x = juce::jlimit(-126.0f, 126.0f, x);
+            // floor() without a libm call or a branch the predictor can miss
+            std::int32_t whole = (std::int32_t)x;
+            whole -= (std::int32_t)(x < (float)whole);
+            const float f = x - (float)whole;
+
+            const float p = 1.0f + f * (6.9314718e-1f + f * (2.4022651e-1f + f * (5.5504109e-2f
+                          + f * (9.6181291e-3f + f * (1.3333558e-3f + f * 1.5403530e-4f)))));
+
+            const std::int32_t bits = (whole + 127) << 23;
+            float scale;
+            std::memcpy(&scale, &bits, sizeof(scale));
+            return p * scale;
+        }
+
+        // Exponent from the float bits; mantissa via the atanh series of log.
+        // Splitting the bits relative to sqrt(0.5) rather than 1.0 centres the
+        // mantissa on 1, in [sqrt(0.5), sqrt(2)), so the series argument stays
+        // within +-1/5.8 without a branch.
+        static inline float log2(float x) noexcept
+        {
+            constexpr std::int32_t sqrtHalfBits = 0x3f3504f3;
+
+            std::int32_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            const std::int32_t offset = bits - sqrtHalfBits;
+            const float e = (float)(offset >> 23);
+
+            bits = (offset & 0x007fffff) + sqrtHalfBits;
+            float m;
+            std::memcpy(&m, &bits, sizeof(m));
+
+            const float s = (m - 1.0f) / (m + 1.0f);
+            const float s2 = s * s;
+            const float series = s * (2.0f + s2 * (2.0f / 3.0f + s2 * (2.0f / 5.0f + s2 * (2.0f / 7.0f + s2 * (2.0f / 9.0f)))));
+            return e + series * 1.4426950f;
+        }
+    };
+
+   #ifndef SYNTH_FAST_MATH
+    #define SYNTH_FAST_MATH 1
+   #endif
+
+    using DefaultPolicy = std::conditional_t<SYNTH_FAST_MATH != 0, Fast, Precise>;
+}
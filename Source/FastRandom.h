@@ -0,0 +1,81 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include <limits>
+
+// xoshiro128+ (Blackman & Vigna): four words of state, a handful of adds,
+// xors and rotates per draw, and no locks or shared state, so the audio
+// thread can own one outright. The seed is explicit, so a session seeded the
+// same way plays back the same glitches and chaos steps.
+//
+// The low bits of xoshiro128+ are its weakest, so floats are built from the
+// top 24 bits only.
+class FastRandom
+{
+public:
+    explicit FastRandom(juce::uint64 seed = defaultSeed) noexcept    { setSeed(seed); }
+
+    static constexpr juce::uint64 defaultSeed = 0x9e3779b97f4a7c15ull;
+
+    void setSeed(juce::uint64 seed) noexcept
+    {
+        // splitmix64 spreads any seed, zero included, over the whole state
+        for (int i = 0; i < 4; i += 2)
+        {
+            seed += 0x9e3779b97f4a7c15ull;
+            juce::uint64 z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            z ^= z >> 31;
+            state[i] = (juce::uint32)z;
+            state[i + 1] = (juce::uint32)(z >> 32);
+        }
+    }
+
+    inline juce::uint32 next() noexcept
+    {
+        const juce::uint32 result = state[0] + state[3];
+        const juce::uint32 t = state[1] << 9;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotateLeft(state[3], 11);
+
+        return result;
+    }
+
+    // [0, 1)
+    inline float nextFloat() noexcept           { return (float)(next() >> 8) * (1.0f / 16777216.0f); }
+
+    // [-1, 1)
+    inline float nextBipolar() noexcept         { return nextFloat() * 2.0f - 1.0f; }
+
+    // Failures before the first success of a trial that succeeds with
+    // probability p, i.e. how many samples to wait for an event that a
+    // per-sample test "nextFloat() < p" would fire. One draw replaces that
+    // whole run of per-sample tests.
+    int nextGeometric(float p) noexcept
+    {
+        if (p >= 1.0f)
+            return 0;
+
+        if (p <= 0.0f)
+            return std::numeric_limits<int>::max();
+
+        // 1 - nextFloat() is in (0, 1], so the log is finite
+        const double u = 1.0 - (double)nextFloat();
+        const double wait = std::floor(std::log(u) / std::log1p(-(double)p));
+        return wait < (double)std::numeric_limits<int>::max() ? (int)wait : std::numeric_limits<int>::max();
+    }
+
+private:
+    juce::uint32 state[4] {};
+
+    static inline juce::uint32 rotateLeft(juce::uint32 x, int k) noexcept
+    {
+        return (x << k) | (x >> (32 - k));
+    }
+};
@@ -23,11 +23,11 @@ public:
     //==============================================================================
     void initialise (const juce::String& commandLine) override
     {
-        juce::ignoreUnused (commandLine);
-
-        // This method is where you should put your application's initialisation code..
+        // --single-threaded keeps voice rendering on the audio thread, for
+        // machines where spinning worker threads cost more than they save
+        const bool parallelVoices = ! commandLine.contains ("--single-threaded");
 
-        mainWindow.reset (new MainWindow (getApplicationName()));
+        mainWindow.reset (new MainWindow (getApplicationName(), parallelVoices));
     }
 
     void shutdown() override
@@ -62,14 +62,14 @@ public:
     class MainWindow    : public juce::DocumentWindow
     {
     public:
-        MainWindow (juce::String name)
+        MainWindow (juce::String name, bool parallelVoices)
             : DocumentWindow (name,
                               juce::Desktop::getInstance().getDefaultLookAndFeel()
                                                           .findColour (juce::ResizableWindow::backgroundColourId),
                               DocumentWindow::allButtons)
         {
             setUsingNativeTitleBar (true);
-            setContentOwned (new MainComponent(), true);
+            setContentOwned (new MainComponent (parallelVoices), true);
 
            #if JUCE_IOS || JUCE_ANDROID
             setFullScreen (true);
@@ -1,13 +1,13 @@
 #include "MainComponent.h"
+#include "FastMath.h"
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 
 namespace
 {
-    constexpr int defaultWidth = 960;
-    constexpr int defaultHeight = 600;
-    constexpr int minWidth = 720;
-    constexpr int minHeight = 420;
+    using Math = dspmath::DefaultPolicy;
+
     constexpr int headerBarHeight = 36;
     constexpr int headerMargin = 16;
     constexpr int audioButtonWidth = 96;
@@ -17,45 +17,67 @@ namespace
     constexpr int toolbarSpacing = 8;
     constexpr int bpmLabelWidth = 84;
     constexpr int defaultBpmDisplay = 120;
-    constexpr int controlStripHeight = 110;
     constexpr int knobSize = 48;
+
+    // The knob strip wraps into rows so every knob gets a column at least
+    // knobSize wide; the minimum width is whatever fits one row of those
+    constexpr int numStripKnobs = 30;
+    constexpr int knobRows = 2;
+    constexpr int knobsPerRow = (numStripKnobs + knobRows - 1) / knobRows;
+    constexpr int minKnobColumn = knobSize + 4;
+    constexpr int knobRowHeight = 84;                  // caption, knob, value and a gap
+    constexpr int controlStripHeight = knobRows * knobRowHeight + 10;
+
+    constexpr int defaultWidth = 960;
+    constexpr int defaultHeight = 680;
+    constexpr int minWidth = std::max(720, 2 * headerMargin + knobsPerRow * minKnobColumn);
+    constexpr int minHeight = 490;
     constexpr int keyboardMinHeight = 60;
     constexpr int scopeTimerHz = 60;
 }
 
 //==============================================================================
-MainComponent::MainComponent()
+MainComponent::MainComponent(bool parallelVoices)
+    : useRenderPool(parallelVoices)
 {
     setSize(defaultWidth, defaultHeight);
-    setAudioChannels(0, 2);
-
-    scopeBuffer.clear();
-    waveformSnapshot.clear();
 
     ampEnvParams.attack = attackMs * 0.001f;
     ampEnvParams.decay = decayMs * 0.001f;
     ampEnvParams.sustain = sustainLevel;
     ampEnvParams.release = releaseMs * 0.001f;
-    amplitudeEnvelope.setParameters(ampEnvParams);
+    voices.setEnvelope(ampEnvParams);
+
+    smoothers.setCurrentAndTargetValue(gainParam, outputGain);
+    smoothers.setCurrentAndTargetValue(cutoffParam, cutoffHz);
+    smoothers.setCurrentAndTargetValue(resonanceParam, resonanceQ);
+    smoothers.setCurrentAndTargetValue(stereoWidthParam, stereoWidth);
+    smoothers.setCurrentAndTargetValue(lfoDepthParam, lfoDepth);
+    smoothers.setCurrentAndTargetValue(driveParam, driveAmount);
+
+    jassert(OscillatorKernel::matchesScalarReference());
 
-    frequencySmoothed.setCurrentAndTargetValue(targetFrequency);
-    gainSmoothed.setCurrentAndTargetValue(outputGain);
-    cutoffSmoothed.setCurrentAndTargetValue(cutoffHz);
-    resonanceSmoothed.setCurrentAndTargetValue(resonanceQ);
-    stereoWidthSmoothed.setCurrentAndTargetValue(stereoWidth);
-    lfoDepthSmoothed.setCurrentAndTargetValue(lfoDepth);
-    driveSmoothed.setCurrentAndTargetValue(driveAmount);
+    // Before any MIDI callback is registered: the queues can't be resized
+    // once either side is running
+    midiInputQueue.prepare(noteQueueSize);
+    keyboardQueue.prepare(noteQueueSize);
+    keyboardDisplayQueue.prepare(noteQueueSize);
+    params.prepare(parameterQueueSize);
 
     midiRoll = std::make_unique<MidiRollComponent>();
     addAndMakeVisible (midiRoll.get());
     oscVisualizer = std::make_unique<OscVisualizerComponent>();
     addAndMakeVisible(oscVisualizer.get());
+    addAndMakeVisible(scopeView);
 
 
     initialiseUi();
     initialiseMidiInputs();
     initialiseKeyboard();
 
+    // Only once every control has pushed its value onto the bus
+    setAudioChannels(0, 2);
+
     startTimerHz(scopeTimerHz);
 }
 
@@ -70,64 +92,39 @@ MainComponent::~MainComponent()
 }
 
 //==============================================================================
-void MainComponent::prepareToPlay(int, double sampleRate)
+void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
 {
     currentSR = sampleRate;
-    phase = 0.0f;
-    lfoPhase = 0.0f;
-    scopeWritePos = 0;
-    filterUpdateCount = 0;
-    subPhase = 0.0f;
-    detunePhase = 0.0f;
-    autoPanPhase = 0.0f;
+    resyncParameters();
+    blockMidi.ensureSize(maxBlockEvents * 16);     // bytes: position, size and data per event
+    voices.prepare(sampleRate, VoiceEngine::defaultVoices);
+    renderPool.start(useRenderPool ? juce::jmin(juce::SystemStats::getNumPhysicalCpus() - 1, voices.getNumBlocks() - 1) : 0,
+                     samplesPerBlockExpected, sampleRate);
+    appliedPitchKnobFrequency = targetFrequency;
+    lfoPhase.reset();
+    scope.reset();
+    autoPanPhase.reset();
     crushCounter = 0;
     crushHoldL = 0.0f;
     crushHoldR = 0.0f;
+    crushOversampler.prepare(renderChunkSize);
+    appliedOversamplingLog2 = -1;
+    applyOversampling();
     chaosValue = 0.0f;
     chaosSamplesRemaining = 0;
     glitchSamplesRemaining = 0;
+    glitchSamplesUntilNext = 0;
+    glitchScheduledProbability = -1.0f;
     glitchHeldL = glitchHeldR = 0.0f;
-    waveformSnapshot.clear();
+    stageWeights.fill(0.0f);
+    stageUnity.fill(1.0f);
+    random.setSeed(FastRandom::defaultSeed);
+    delayLine.prepare(juce::jmax(1, (int)std::ceil(sampleRate * 2.0)), 2);
+    delayLine.setInterpolation(DelayLine::lagrangeInterpolation);
     resetSmoothers(sampleRate);
-    updateFilterStatic();
-    amplitudeEnvelope.setSampleRate(sampleRate);
     updateAmplitudeEnvelope();
-    amplitudeEnvelope.reset();
     triggerLfo();
-
-    maxDelaySamples = juce::jmax(1, (int)std::ceil(sampleRate * 2.0));
-    delayBuffer.setSize(2, maxDelaySamples);
-    delayBuffer.clear();
-    delayWritePosition = 0;
-}
-
-void MainComponent::updateFilterCoeffs(double cutoff, double Q)
-{
-    cutoff = juce::jlimit(20.0, 20000.0, cutoff);
-    Q = juce::jlimit(0.1, 12.0, Q);
-
-    const double w0 = juce::MathConstants<double>::twoPi * cutoff / currentSR;
-    const double cw = std::cos(w0);
-    const double sw = std::sin(w0);
-    const double alpha = sw / (2.0 * Q);
-
-    double b0 = (1.0 - cw) * 0.5;
-    double b1 = 1.0 - cw;
-    double b2 = (1.0 - cw) * 0.5;
-    double a0 = 1.0 + alpha;
-    double a1 = -2.0 * cw;
-    double a2 = 1.0 - alpha;
-
-    juce::IIRCoefficients c(b0 / a0, b1 / a0, b2 / a0,
-        1.0, a1 / a0, a2 / a0);
-
-    filterL.setCoefficients(c);
-    filterR.setCoefficients(c);
-}
-
-void MainComponent::updateFilterStatic()
-{
-    updateFilterCoeffs(cutoffHz, resonanceQ);
+    analyser.start(sampleRate);
 }
 
 void MainComponent::resetSmoothers(double sampleRate)
@@ -135,519 +132,662 @@ void MainComponent::resetSmoothers(double sampleRate)
     const double fastRampSeconds = 0.02;
     const double filterRampSeconds = 0.06;
     const double spatialRampSeconds = 0.1;
-
-    frequencySmoothed.reset(sampleRate, fastRampSeconds);
-    gainSmoothed.reset(sampleRate, fastRampSeconds);
-    cutoffSmoothed.reset(sampleRate, filterRampSeconds);
-    resonanceSmoothed.reset(sampleRate, filterRampSeconds);
-    stereoWidthSmoothed.reset(sampleRate, spatialRampSeconds);
-    lfoDepthSmoothed.reset(sampleRate, spatialRampSeconds);
-    driveSmoothed.reset(sampleRate, fastRampSeconds);
-
-    frequencySmoothed.setCurrentAndTargetValue(targetFrequency);
-    gainSmoothed.setCurrentAndTargetValue(outputGain);
-    cutoffSmoothed.setCurrentAndTargetValue(cutoffHz);
-    resonanceSmoothed.setCurrentAndTargetValue(resonanceQ);
-    stereoWidthSmoothed.setCurrentAndTargetValue(stereoWidth);
-    lfoDepthSmoothed.setCurrentAndTargetValue(lfoDepth);
-    driveSmoothed.setCurrentAndTargetValue(driveAmount);
-
-    filterL.reset();
-    filterR.reset();
+    const double delayTimeRampSeconds = 0.25;
+
+    smoothers.reset(gainParam, sampleRate, fastRampSeconds);
+    smoothers.reset(cutoffParam, sampleRate, filterRampSeconds);
+    smoothers.reset(resonanceParam, sampleRate, filterRampSeconds);
+    smoothers.reset(stereoWidthParam, sampleRate, spatialRampSeconds);
+    smoothers.reset(lfoDepthParam, sampleRate, spatialRampSeconds);
+    smoothers.reset(driveParam, sampleRate, fastRampSeconds);
+    smoothers.reset(delayTimeParam, sampleRate, delayTimeRampSeconds);
+
+    smoothers.setCurrentAndTargetValue(gainParam, outputGain);
+    smoothers.setCurrentAndTargetValue(cutoffParam, cutoffHz);
+    smoothers.setCurrentAndTargetValue(resonanceParam, resonanceQ);
+    smoothers.setCurrentAndTargetValue(stereoWidthParam, stereoWidth);
+    smoothers.setCurrentAndTargetValue(lfoDepthParam, lfoDepth);
+    smoothers.setCurrentAndTargetValue(driveParam, driveAmount);
+    smoothers.setCurrentAndTargetValue(delayTimeParam, getDelayTimeSamples(delayAmount));
 }
 
-void MainComponent::setTargetFrequency(float newFrequency, bool force)
+float MainComponent::getDelayTimeSamples(float amount) const noexcept
 {
-    targetFrequency = juce::jlimit(20.0f, 20000.0f, newFrequency);
+    // Whole samples, so a settled delay reads back as straight copies
+    const double longest = juce::jmin(currentSR * 1.25, (double)delayLine.getMaxDelaySamples());
+    return (float)std::round(juce::jmap((double)juce::jlimit(0.0f, 1.0f, amount), 0.0, 1.0,
+                                        juce::jmin(currentSR * 0.03, longest), longest));
+}
 
-    if (force)
-        frequencySmoothed.setCurrentAndTargetValue(targetFrequency);
-    else
-        frequencySmoothed.setTargetValue(targetFrequency);
+void MainComponent::updateWavetableShape()
+{
+    WavetableOscillator::Shape shape;
+    shape.morph = params.get(Param::waveMorph);
+    shape.chaos = params.get(Param::chaos);
+    shape.spread = params.get(Param::subMix);
+    shape.maxPartials = (int)params.get(Param::partials);
+    wavetable.setShape(shape);
 }
 
-inline float MainComponent::polyBlep(float t, float dt) const
+void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
 {
-    if (dt <= 0.0f)
-        return 0.0f;
+    if (bufferToFill.buffer == nullptr || bufferToFill.buffer->getNumChannels() == 0)
+        return;
 
-    if (t < dt)
-    {
-        t /= dt;
-        return t + t - t * t - 1.0f;
-    }
+    bufferToFill.buffer->clear(bufferToFill.startSample, bufferToFill.numSamples);
+
+    // Piano-roll notes at their sample offsets, then whatever hardware MIDI,
+    // the on-screen keyboard and the parameter bus queued since the last
+    // block, placed by when it arrived. All offsets are relative to the start
+    // of this block. The roll's buffer can't be read again, so it goes first;
+    // the queues only pop what still fits and keep the rest for next block.
+    // Parameter changes go last so a burst of them never costs a note.
+    const double blockStartMs = juce::Time::getMillisecondCounterHiRes();
+
+    blockMidi.clear();
+    if (midiRoll)
+        midiRoll->renderNextMidiBlock(blockMidi, bufferToFill.numSamples, currentSR);
 
-    if (t > 1.0f - dt)
+    numBlockEvents = 0;
+    collectBlockEvents(blockMidi, bufferToFill.numSamples);
+    drainNoteQueue(midiInputQueue, bufferToFill.numSamples, blockStartMs, true);
+    drainNoteQueue(keyboardQueue, bufferToFill.numSamples, blockStartMs, false);
+    drainParameterChanges(bufferToFill.numSamples, blockStartMs);
+    sortBlockEvents();
+
+    const auto& tables = wavetable.acquireTables();
+
+    renderPool.beginCallback();
+
+    auto* l = bufferToFill.buffer->getWritePointer(0, bufferToFill.startSample);
+    auto* r = bufferToFill.buffer->getNumChannels() > 1
+        ? bufferToFill.buffer->getWritePointer(1, bufferToFill.startSample) : nullptr;
+
+    bool glitchActivity = glitchSamplesRemaining > 0;
+
+    int nextEvent = 0;
+
+    for (int chunkStart = 0; chunkStart < bufferToFill.numSamples;)
     {
-        t = (t - 1.0f) / dt;
-        return t * t + t + t + 1.0f;
+        // Apply everything due at this sample, then render up to the next
+        // event so it lands exactly where it was scheduled
+        while (nextEvent < numBlockEvents && blockEvents[(size_t)nextEvent].sampleOffset <= chunkStart)
+            applyBlockEvent(blockEvents[(size_t)nextEvent++]);
+
+        int chunkEnd = juce::jmin(chunkStart + renderChunkSize, bufferToFill.numSamples);
+        if (nextEvent < numBlockEvents)
+            chunkEnd = juce::jmin(chunkEnd, blockEvents[(size_t)nextEvent].sampleOffset);
+
+        const int chunkLength = chunkEnd - chunkStart;
+
+        // ===== Settings for this chunk, now that its events are applied =====
+        voices.setUnison(unisonVoices, unisonSpread, unisonStereo);
+        applyOversampling();
+
+        if (targetFrequency != appliedPitchKnobFrequency)
+        {
+            appliedPitchKnobFrequency = targetFrequency;
+            voices.retuneNewestVoice(targetFrequency);
+        }
+
+        const juce::uint32 lfoInc = PhaseAccumulator::toIncrement(lfoRateHz / (float)currentSR);
+        const juce::uint32 autoPanInc = PhaseAccumulator::toIncrement(autoPanRateHz / (float)currentSR);
+        const float crushAmt = juce::jlimit(0.0f, 1.0f, crushAmount);
+        const float subMixAmt = juce::jlimit(0.0f, 1.0f, subMixAmount);
+        const float envFilterAmt = juce::jlimit(-1.0f, 1.0f, envFilterAmount);
+        const float chaosAmt = juce::jlimit(0.0f, 1.0f, chaosAmount);
+        const float delayAmtLocal = juce::jlimit(0.0f, 1.0f, delayAmount);
+        const float autoPanAmt = juce::jlimit(0.0f, 1.0f, autoPanAmount);
+        const float glitchProbLocal = juce::jlimit(0.0f, 1.0f, glitchProbability);
+        const float delayMix = juce::jmap(delayAmtLocal, 0.0f, 1.0f, 0.0f, 0.65f);
+        const float delayFeedback = juce::jmap(delayAmtLocal, 0.0f, 1.0f, 0.05f, 0.88f);
+
+        // The delay time glides to its new length, so moving the knob bends the
+        // repeats like a tape delay instead of clicking.
+        smoothers.setTargetValue(delayTimeParam, getDelayTimeSamples(delayAmtLocal));
+
+        // A hold starts on any sample with probability glitchProb / 100. Rather
+        // than testing every sample, draw the wait until the next start; the
+        // wait is memoryless, so it can simply be redrawn when the knob moves.
+        if (glitchProbLocal != glitchScheduledProbability)
+        {
+            glitchScheduledProbability = glitchProbLocal;
+            glitchSamplesUntilNext = random.nextGeometric(glitchProbLocal * 0.01f);
+        }
+
+        // Advance every smoothed parameter for the chunk in one go
+        smoothers.process(chunkLength);
+
+        ChunkSettings settings;
+        settings.tables = &tables;
+        settings.left = l + chunkStart;
+        settings.right = r != nullptr ? r + chunkStart : nullptr;
+        settings.numSamples = chunkLength;
+        settings.lfoInc = lfoInc;
+        settings.autoPanInc = autoPanInc;
+        settings.chaosAmount = chaosAmt;
+        settings.autoPanAmount = autoPanAmt;
+        settings.glitchProbability = glitchProbLocal;
+        settings.subMix = subMixAmt;
+        settings.envFilterAmount = envFilterAmt;
+        settings.crushAmount = crushAmt;
+        settings.delayMix = delayMix;
+        settings.delayFeedback = delayFeedback;
+
+        const int stages = (chaosAmt > 0.0f ? chaosStage : 0)
+                         | (autoPanAmt > 0.0f ? autoPanStage : 0)
+                         | (glitchProbLocal > 0.0f ? glitchStage : 0)
+                         | (r != nullptr ? stereoOutput : 0);
+
+        if (renderChunk(stages, settings))
+            glitchActivity = true;
+
+        scope.push(l + chunkStart, chunkLength);
+        analyser.pushSamples(analysisMono.data(), chunkLength);
+
+        chunkStart = chunkEnd;
     }
 
-    return 0.0f;
+    renderPool.endCallback();
+
+    if (glitchActivity)
+        analyser.noteGlitchActivity();
 }
 
-inline float MainComponent::renderMorphSample(float ph, float morph, float normPhaseInc) const
+//==============================================================================
+// Stage-specialised chunk rendering
+template <size_t... Index>
+constexpr std::array<MainComponent::ChunkRenderer, sizeof...(Index)>
+MainComponent::makeChunkRenderers(std::index_sequence<Index...>) noexcept
 {
-    // ===== Fractal Oscillator Core (drop‑in) =====
-    // Keeps original 4‑shape morph, then layers a small number of
-    // band‑limited sine partials whose behaviour is driven by:
-    //   chaosAmount  -> number of partials / irregularity
-    //   subMixAmount -> even/odd bias (tone colour)
-    //   lfoDepth     -> gentle weight motion via lfoPhase
-    //
-    // No header/UI changes. Safe for JUCE 8 / C++17.
-
-    // --- Phase wrap ---
-    while (ph >= juce::MathConstants<float>::twoPi) ph -= juce::MathConstants<float>::twoPi;
-    if (ph < 0.0f) ph += juce::MathConstants<float>::twoPi;
-
-    const float m = juce::jlimit(0.0f, 1.0f, morph);
-    const float seg = 1.0f / 3.0f;
-
-    // --- Base waves (existing) ---
-    const float sineSample = sine(ph);
-    const float triSample  = tri(ph);
-
-    // Normalised phase increment per sample in cycles (0..0.5 usually)
-    const float dt = juce::jlimit(1.0e-6f, 0.5f, normPhaseInc);
-
-    // Fractional phase [0,1)
-    float t = ph / juce::MathConstants<float>::twoPi;
-    t -= std::floor(t);
-
-    // BLEP anti-aliased saw
-    float sawSample = 2.0f * t - 1.0f;
-    sawSample -= polyBlep(t, dt);
-    sawSample = juce::jlimit(-1.2f, 1.2f, sawSample);
-
-    // BLEP anti-aliased square (50% duty)
-    float squareSample = t < 0.5f ? 1.0f : -1.0f;
-    squareSample += polyBlep(t, dt);
-    float t2 = t + 0.5f; t2 -= std::floor(t2);
-    squareSample -= polyBlep(t2, dt);
-    squareSample = std::tanh(squareSample * 1.15f);
-
-    // Smooth morph across four shapes
-    float base;
-    if (m < seg)            base = juce::jmap(m / seg,                 sineSample,  triSample);
-    else if (m < 2.0f*seg)  base = juce::jmap((m - seg) / seg,         triSample,   sawSample);
-    else                    base = juce::jmap((m - 2.0f*seg) / seg,    sawSample,   squareSample);
-
-    // --- Fractal layering (new) ---
-    const float chaos   = juce::jlimit(0.0f, 1.0f, chaosAmount);
-    const float spread  = juce::jlimit(0.0f, 1.0f, subMixAmount);   // colour bias
-    const float motion  = juce::jlimit(0.0f, 1.0f, lfoDepth);       // gentle movement
-
-    // Max usable harmonic by Nyquist: k * dt < 0.5 => k < 0.5/dt
-    int maxNyquistH = (int)std::floor(0.5f / dt);
-    maxNyquistH = juce::jlimit(1, 64, maxNyquistH); // safety cap
-
-    // Choose small number of partials based on chaos (1..6) but never exceed Nyquist
-    const int desired = 1 + (int)std::round(chaos * 5.0f);
-    const int partials = juce::jlimit(1, juce::jmin(6, maxNyquistH), desired);
-
-    // Amplitude rolloff (steeper at low chaos)
-    const float rolloff = juce::jmap(chaos, 0.0f, 1.0f, 0.75f, 0.45f);
-
-    // Even/odd emphasis via spread
-    const float evenBias = juce::jlimit(0.0f, 1.0f, spread * 0.85f);
-    const float oddBias  = juce::jlimit(0.0f, 1.0f, 1.0f - spread * 0.65f);
-
-    // Subtle time motion ties timbre to LFO state (read‑only usage)
-    const float timeMod = std::sin(lfoPhase) * motion * 0.25f;
-
-    float layered = base;
-    float norm = 1.0f;
-
-    // Sum a few sine partials (band-limited) with biased weights.
-    // Using sines keeps alias low; additional BLEP not needed on harmonics.
-    for (int k = 2; k <= partials + 1; ++k)
-    {
-        if (k > maxNyquistH) break;
-
-        const bool isEven = (k % 2 == 0);
-        const float bias = isEven ? evenBias : oddBias;
-
-        // Weight decays with power; add tiny motion and chaos wobble
-        const float wobble = 1.0f + 0.12f * chaos * std::sin((float)k * (lfoPhase + 0.37f)) + timeMod;
-        const float w = std::pow(rolloff, (float)(k - 1)) * juce::jlimit(0.0f, 1.0f, 0.6f + 0.4f * bias) * wobble;
-
-        layered += w * std::sin((float)k * ph);
-        norm += w;
+    // Plain renderers first, then the crossfading ones
+    return { { &MainComponent::renderChunkStages<(int)(Index % (size_t)numStageMasks),
+                                                 (Index >= (size_t)numStageMasks)>... } };
+}
+
+bool MainComponent::renderChunk(int stages, ChunkSettings& settings) noexcept
+{
+    static constexpr auto renderers = makeChunkRenderers(std::make_index_sequence<(size_t)numStageMasks * 2>());
+
+    if ((stages & chaosStage) != 0)      heldChaosAmount = settings.chaosAmount;
+    if ((stages & autoPanStage) != 0)    heldAutoPanAmount = settings.autoPanAmount;
+    if ((stages & glitchStage) != 0)     heldGlitchProbability = settings.glitchProbability;
+
+    // Move each stage's weight linearly towards on or off, continuing from
+    // where the previous chunk left it
+    constexpr float rampStep = 1.0f / (float)stageCrossfadeSamples;
+    const int numSamples = settings.numSamples;
+    int rampingStages = 0;
+
+    for (int i = 0; i < numFadingStages; ++i)
+    {
+        const bool on = (stages & (1 << i)) != 0;
+        float weight = stageWeights[(size_t)i];
+
+        if (weight == (on ? 1.0f : 0.0f))
+            continue;
+
+        rampingStages |= 1 << i;
+        auto& ramp = stageRamps[(size_t)i];
+
+        for (int j = 0; j < numSamples; ++j)
+        {
+            weight = on ? juce::jmin(1.0f, weight + rampStep) : juce::jmax(0.0f, weight - rampStep);
+            ramp[(size_t)j] = weight;
+        }
+
+        stageWeights[(size_t)i] = weight;
     }
 
-    // Normalise and blend with original; layerMix scales with chaos
-    layered = juce::jlimit(-1.5f, 1.5f, layered / juce::jmax(1.0f, norm));
-    const float layerMix = juce::jlimit(0.0f, 1.0f, juce::jmap(chaos, 0.0f, 1.0f, 0.0f, 0.85f));
+    if (rampingStages == 0)
+        return (this->*renderers[(size_t)stages])(settings);
+
+    auto gainFor = [&](int index)
+    {
+        return (rampingStages & (1 << index)) != 0 ? stageRamps[(size_t)index].data() : stageUnity.data();
+    };
+
+    settings.chaosGain = gainFor(0);
+    settings.autoPanGain = gainFor(1);
+    settings.glitchGain = gainFor(2);
 
-    float out = juce::jmap(layerMix, base, layered);
+    // A stage on its way out keeps the amount it had when it was switched off
+    const int fadingOut = rampingStages & ~stages;
 
-    // Final tiny soft clip to keep headroom consistent
-    return std::tanh(out * 1.1f);
+    if ((fadingOut & chaosStage) != 0)      settings.chaosAmount = heldChaosAmount;
+    if ((fadingOut & autoPanStage) != 0)    settings.autoPanAmount = heldAutoPanAmount;
+    if ((fadingOut & glitchStage) != 0)     settings.glitchProbability = heldGlitchProbability;
+
+    return (this->*renderers[(size_t)((stages | rampingStages) + numStageMasks)])(settings);
 }
 
-void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
+template <int Stages, bool Crossfade>
+bool MainComponent::renderChunkStages(const ChunkSettings& s) noexcept
 {
-    if (bufferToFill.buffer == nullptr || bufferToFill.buffer->getNumChannels() == 0)
-        return;
+    constexpr bool chaosOn = (Stages & chaosStage) != 0;
+    constexpr bool autoPanOn = (Stages & autoPanStage) != 0;
+    constexpr bool glitchOn = (Stages & glitchStage) != 0;
+    constexpr bool stereo = (Stages & stereoOutput) != 0;
 
-    bufferToFill.buffer->clear(bufferToFill.startSample, bufferToFill.numSamples);
-
-    juce::MidiBuffer midiRollBuffer;
-    if (midiRoll)
-        midiRoll->renderNextMidiBlock(midiRollBuffer, bufferToFill.numSamples, currentSR);
+    const int numSamples = s.numSamples;
+    const float* lfoDepthRamp = smoothers.getBuffer(lfoDepthParam);
+    const float* stereoWidthRamp = smoothers.getBuffer(stereoWidthParam);
 
-    keyboardState.processNextMidiBuffer(midiRollBuffer, bufferToFill.startSample, bufferToFill.numSamples, true);
+    // ===== Control pass: modulation shared by every voice for the whole chunk =====
+    for (int j = 0; j < numSamples; ++j)
+    {
+        const float depth = lfoDepthRamp[j];
 
-    auto* l = bufferToFill.buffer->getWritePointer(0, bufferToFill.startSample);
-    auto* r = bufferToFill.buffer->getNumChannels() > 1
-        ? bufferToFill.buffer->getWritePointer(1, bufferToFill.startSample) : nullptr;
+        float lfoS = Math::sin(lfoPhase.getRadians());
+        float modulation = 1.0f + (depth * lfoS);
+        lfoPhase.advance(s.lfoInc);
 
-    const float lfoInc = juce::MathConstants<float>::twoPi * lfoRateHz / (float)currentSR;
-    const float autoPanInc = juce::MathConstants<float>::twoPi * autoPanRateHz / (float)currentSR;
-    const float crushAmt = juce::jlimit(0.0f, 1.0f, crushAmount);
-    const float subMixAmt = juce::jlimit(0.0f, 1.0f, subMixAmount);
-    const float envFilterAmt = juce::jlimit(-1.0f, 1.0f, envFilterAmount);
-    const float chaosAmt = juce::jlimit(0.0f, 1.0f, chaosAmount);
-    const float delayAmtLocal = juce::jlimit(0.0f, 1.0f, delayAmount);
-    const float autoPanAmt = juce::jlimit(0.0f, 1.0f, autoPanAmount);
-    const float glitchProbLocal = juce::jlimit(0.0f, 1.0f, glitchProbability);
-    const float delayMix = juce::jmap(delayAmtLocal, 0.0f, 1.0f, 0.0f, 0.65f);
-    const float delayFeedback = juce::jmap(delayAmtLocal, 0.0f, 1.0f, 0.05f, 0.88f);
-    const int delaySamples = (maxDelaySamples > 1)
-        ? juce::jlimit(1, maxDelaySamples - 1,
-            (int)std::round(juce::jmap((double)delayAmtLocal, 0.0, 1.0,
-                currentSR * 0.03,
-                juce::jmin(currentSR * 1.25, (double)maxDelaySamples - 1.0))))
-        : 1;
-
-    float blockPeak = 0.0f;
-    float lowState = lowBandState;
-    float midState = midBandState;
-    float lowAccum = 0.0f;
-    float midAccum = 0.0f;
-    float highAccum = 0.0f;
-    float glitchActivity = glitchSamplesRemaining > 0 ? 1.0f : 0.0f;
-
-    for (int i = 0; i < bufferToFill.numSamples; ++i)
-    {
-        if (!audioEnabled && amplitudeEnvelope.isActive())
-            amplitudeEnvelope.noteOff();
-
-        const float baseFrequency = frequencySmoothed.getNextValue();
-        const float gain = gainSmoothed.getNextValue() * currentVelocity;
-        const float depth = lfoDepthSmoothed.getNextValue();
-        const float width = stereoWidthSmoothed.getNextValue();
-        const float baseCutoff = cutoffSmoothed.getNextValue();
-        const float baseResonance = resonanceSmoothed.getNextValue();
-        const float ampEnv = amplitudeEnvelope.getNextSample();
-        const float drive = driveSmoothed.getNextValue();
-
-        float lfoS = std::sin(lfoPhase);
-        float vibrato = 1.0f + (depth * lfoS);
-        lfoPhase += lfoInc;
-        if (lfoPhase >= juce::MathConstants<float>::twoPi) lfoPhase -= juce::MathConstants<float>::twoPi;
-
-        float chaosScale = 1.0f;
-        if (chaosAmt > 0.0f)
+        if constexpr (chaosOn)
         {
             if (chaosSamplesRemaining <= 0)
             {
-                const int span = juce::jmax(1, (int)std::round(juce::jmap(chaosAmt, 0.0f, 1.0f,
+                // Step lengths are geometric around the mean span, so the
+                // steps land irregularly rather than on a fixed grid.
+                const int span = juce::jmax(1, (int)std::round(juce::jmap(s.chaosAmount, 0.0f, 1.0f,
                     (float)currentSR * 0.18f,
                     (float)currentSR * 0.01f)));
-                chaosSamplesRemaining = span;
-                chaosValue = random.nextFloat() * 2.0f - 1.0f;
+                chaosSamplesRemaining = 1 + random.nextGeometric(1.0f / (float)span);
+                chaosValue = random.nextBipolar();
             }
-            chaosScale = juce::jlimit(0.7f, 1.3f, 1.0f + chaosValue * chaosAmt * 0.10f);
+
+            float amount = s.chaosAmount;
+            if constexpr (Crossfade)
+                amount *= s.chaosGain[j];
+
+            modulation *= juce::jlimit(0.7f, 1.3f, 1.0f + chaosValue * amount * 0.10f);
             --chaosSamplesRemaining;
         }
-        else
-        {
-            chaosValue = 0.0f;
-            chaosSamplesRemaining = 0;
-        }
 
-        const float effectiveFrequency = baseFrequency * chaosScale;
-        const float phaseInc = juce::MathConstants<float>::twoPi * (effectiveFrequency * vibrato) / (float)currentSR;
-        phase += phaseInc;
-        if (phase >= juce::MathConstants<float>::twoPi) phase -= juce::MathConstants<float>::twoPi;
-
-        float subPhaseInc = phaseInc * 0.5f;
-        float detunePhaseInc = phaseInc * 1.01f;
-        subPhase += subPhaseInc;
-        detunePhase += detunePhaseInc;
-        if (subPhase >= juce::MathConstants<float>::twoPi) subPhase -= juce::MathConstants<float>::twoPi;
-        if (detunePhase >= juce::MathConstants<float>::twoPi) detunePhase -= juce::MathConstants<float>::twoPi;
-
-        const float normInc = phaseInc / juce::MathConstants<float>::twoPi;
-        const float subNormInc = subPhaseInc / juce::MathConstants<float>::twoPi;
-        const float detuneNormInc = detunePhaseInc / juce::MathConstants<float>::twoPi;
-
-        float primary = renderMorphSample(phase, waveMorph, normInc);
-        float subSample = renderMorphSample(subPhase, waveMorph, subNormInc);
-        float detuneSample = renderMorphSample(detunePhase, waveMorph, detuneNormInc);
-        float stacked = juce::jlimit(-1.0f, 1.0f,
-            primary * 0.55f + subSample * 0.35f + detuneSample * 0.35f);
-        float combined = juce::jmap(subMixAmt, primary, stacked);
-        float s = combined * gain;
-
-        if (drive > 0.0f)
-        {
-            float preGain = 1.5f + drive * 9.0f;
-            float softClip = std::tanh(s * preGain);
-            float evenHarmonics = std::tanh((s * preGain) * 0.6f) * 0.8f;
-            float shaped = juce::jlimit(-1.0f, 1.0f, 0.65f * softClip + 0.35f * evenHarmonics);
-            s = juce::jmap(drive, 0.0f, 1.0f, s, shaped);
-        }
+        pitchModulation[(size_t)j] = modulation;
+        lfoValues[(size_t)j] = lfoS;
+    }
 
-        if (++filterUpdateCount >= filterUpdateStep)
-        {
-            filterUpdateCount = 0;
-            const double modFactor = std::pow(2.0, (double)lfoCutModAmt * (double)lfoS);
-            const double envFactor = juce::jlimit(0.1, 4.0, 1.0 + (double)envFilterAmt * (double)ampEnv);
-            const double effCut = juce::jlimit(80.0, 14000.0, (double)baseCutoff * modFactor * envFactor);
-            updateFilterCoeffs(effCut, (double)baseResonance);
-        }
+    if constexpr (!chaosOn)
+    {
+        chaosValue = 0.0f;
+        chaosSamplesRemaining = 0;
+    }
 
-        float fL = filterL.processSingleSampleRaw(s);
-        float fR = (r ? filterR.processSingleSampleRaw(s) : fL);
+    // ===== Voices: oscillators, drive, filter and envelope per voice =====
+    VoiceEngine::ChunkControls controls;
+    controls.pitchMod = pitchModulation.data();
+    controls.lfo = lfoValues.data();
+    controls.gain = smoothers.getBuffer(gainParam);
+    controls.cutoff = smoothers.getBuffer(cutoffParam);
+    controls.resonance = smoothers.getBuffer(resonanceParam);
+    controls.drive = smoothers.getBuffer(driveParam);
+    controls.subMix = s.subMix;
+    controls.envFilterAmount = s.envFilterAmount;
+    controls.lfoCutModAmount = lfoCutModAmt;
+    controls.filterMode = filterMode;
 
-        if (crushAmt > 0.0f)
-        {
-            if (crushCounter <= 0)
-            {
-                const int downsampleFactor = juce::jmax(1, (int)std::round(juce::jmap(crushAmt, 0.0f, 1.0f, 1.0f, 32.0f)));
-                crushCounter = downsampleFactor;
-                crushHoldL = fL;
-                crushHoldR = fR;
-            }
+    voices.render(*s.tables, controls, numSamples, voiceMixL.data(), voiceMixR.data(), &renderPool);
 
-            float levels = juce::jmap(crushAmt, 0.0f, 1.0f, 2048.0f, 6.0f);
-            float crushedL = std::round(crushHoldL * levels) / levels;
-            float crushedR = std::round(crushHoldR * levels) / levels;
-            fL = juce::jmap(crushAmt, 0.0f, 1.0f, fL, crushedL);
-            fR = juce::jmap(crushAmt, 0.0f, 1.0f, fR, crushedR);
-            --crushCounter;
-        }
-        else
-        {
-            crushCounter = 0;
-        }
+    applyCrush(voiceMixL.data(), voiceMixR.data(), numSamples, s.crushAmount);
 
-        fL *= ampEnv;
-        fR *= ampEnv;
+    for (int j = 0; j < numSamples; ++j)
+    {
+        const float width = stereoWidthRamp[j];
+
+        const float fL = voiceMixL[(size_t)j];
+        const float fR = voiceMixR[(size_t)j];
+        float dynamicWidth = width;
 
-        float panMod = autoPanAmt * std::sin(autoPanPhase);
-        autoPanPhase += autoPanInc;
-        if (autoPanPhase >= juce::MathConstants<float>::twoPi) autoPanPhase -= juce::MathConstants<float>::twoPi;
+        if constexpr (autoPanOn)
+        {
+            float panMod = s.autoPanAmount * Math::sin(autoPanPhase.getRadians());
+            if constexpr (Crossfade)
+                panMod *= s.autoPanGain[j];
+
+            autoPanPhase.advance(s.autoPanInc);
+            dynamicWidth = width * juce::jlimit(0.0f, 3.0f, 1.0f + panMod);
+        }
 
-        float dynamicWidth = width * juce::jlimit(0.0f, 3.0f, 1.0f + panMod);
         float mid = 0.5f * (fL + fR);
         float side = 0.5f * (fL - fR) * dynamicWidth;
 
-        float dryL = mid + side;
-        float dryR = r ? (mid - side) : dryL;
+        const float panL = mid + side;
+        voiceMixL[(size_t)j] = panL;
+        voiceMixR[(size_t)j] = stereo ? (mid - side) : panL;
+    }
 
-        float wetL = 0.0f;
-        float wetR = 0.0f;
-        if (delayAmtLocal > 0.0f && maxDelaySamples > 1)
-        {
-            const int readPos = (delayWritePosition - delaySamples + maxDelaySamples) % maxDelaySamples;
-            wetL = delayBuffer.getSample(0, readPos);
-            wetR = delayBuffer.getNumChannels() > 1 ? delayBuffer.getSample(1, readPos) : wetL;
+    // The pan LFO keeps running while it's unused, so it picks up in phase
+    if constexpr (!autoPanOn)
+        autoPanPhase.advance(s.autoPanInc * (juce::uint32)numSamples);
 
-            delayBuffer.setSample(0, delayWritePosition, dryL + wetL * delayFeedback);
-            delayBuffer.setSample(1, delayWritePosition, dryR + wetR * delayFeedback);
-            delayWritePosition = (delayWritePosition + 1) % maxDelaySamples;
+    applyDelay(voiceMixL.data(), voiceMixR.data(), numSamples, s.delayMix, s.delayFeedback);
 
-            dryL = dryL * (1.0f - delayMix) + wetL * delayMix;
-            dryR = dryR * (1.0f - delayMix) + wetR * delayMix;
-        }
-        else if (maxDelaySamples > 1)
-        {
-            delayBuffer.setSample(0, delayWritePosition, dryL);
-            delayBuffer.setSample(1, delayWritePosition, dryR);
-            delayWritePosition = (delayWritePosition + 1) % maxDelaySamples;
-        }
+    bool glitchActivity = false;
 
-        if (glitchProbLocal > 0.0f)
+    for (int j = 0; j < numSamples; ++j)
+    {
+        float dryL = voiceMixL[(size_t)j];
+        float dryR = voiceMixR[(size_t)j];
+
+        if constexpr (glitchOn)
         {
             if (glitchSamplesRemaining > 0)
             {
                 --glitchSamplesRemaining;
-                dryL = glitchHeldL;
-                dryR = glitchHeldR;
+
+                if constexpr (Crossfade)
+                {
+                    const float g = s.glitchGain[j];
+                    dryL += (glitchHeldL - dryL) * g;
+                    dryR += (glitchHeldR - dryR) * g;
+                }
+                else
+                {
+                    dryL = glitchHeldL;
+                    dryR = glitchHeldR;
+                }
+            }
+            else if (glitchSamplesUntilNext > 0)
+            {
+                --glitchSamplesUntilNext;
             }
-            else if (random.nextFloat() < glitchProbLocal * 0.01f)
+            else
             {
-                glitchSamplesRemaining = juce::jmax(4, (int)std::round(juce::jmap(glitchProbLocal, 0.0f, 1.0f,
+                glitchSamplesRemaining = juce::jmax(4, (int)std::round(juce::jmap(s.glitchProbability, 0.0f, 1.0f,
                     12.0f,
                     (float)currentSR * 0.08f)));
+                glitchSamplesUntilNext = random.nextGeometric(s.glitchProbability * 0.01f);
                 glitchHeldL = dryL;
                 glitchHeldR = dryR;
             }
-        }
-        else
-        {
-            glitchSamplesRemaining = 0;
+
+            if (glitchSamplesRemaining > 0)
+                glitchActivity = true;
         }
 
-        const float mono = r ? 0.5f * (dryL + dryR) : dryL;
-        blockPeak = juce::jmax(blockPeak, std::abs(mono));
+        analysisMono[(size_t)j] = stereo ? 0.5f * (dryL + dryR) : dryL;
 
-        lowState += 0.04f * (mono - lowState);
-        const float highPass = mono - lowState;
-        midState += 0.08f * (highPass - midState);
-        const float highComponent = highPass - midState;
+        s.left[j] = dryL;
+        if constexpr (stereo)
+            s.right[j] = dryR;
+    }
+
+    if constexpr (!glitchOn)
+        glitchSamplesRemaining = 0;
 
-        lowAccum += std::abs(lowState);
-        midAccum += std::abs(midState);
-        highAccum += std::abs(highComponent);
+    return glitchActivity;
+}
+
+void MainComponent::applyOversampling()
+{
+    if (oversamplingLog2 == appliedOversamplingLog2)
+        return;
 
-        if (glitchSamplesRemaining > 0)
-            glitchActivity = 1.0f;
+    appliedOversamplingLog2 = oversamplingLog2;
+    voices.setOversampling(oversamplingLog2);
+    crushOversampler.setFactorLog2(oversamplingLog2);
+    latencySamples.store(juce::roundToInt(voices.getLatencySamples() + crushOversampler.getLatencySamples()));
+    crushOversampleState[0].reset();
+    crushOversampleState[1].reset();
+    crushStereo = false;
+}
 
-        l[i] = dryL;
-        if (r) r[i] = dryR;
+void MainComponent::applyCrush(float* left, float* right, int numSamples, float crushAmt) noexcept
+{
+    const int factor = crushOversampler.getFactor();
 
-        scopeBuffer.setSample(0, scopeWritePos, l[i]);
-        scopeWritePos = (scopeWritePos + 1) % scopeBuffer.getNumSamples();
+    if (crushAmt <= 0.0f && factor == 1)
+    {
+        crushCounter = 0;
+        return;
     }
 
-    lowBandState = lowState;
-    midBandState = midState;
+    // Identical channels with identical state crush identically, so a mono
+    // chunk only runs the left side. Once the right side has diverged it
+    // keeps its own pass until the states have caught up again.
+    const bool monoInput = std::equal(left, left + numSamples, right);
+    const bool stereoPass = !monoInput || crushStereo;
 
-    const float invSamples = bufferToFill.numSamples > 0 ? 1.0f / (float)bufferToFill.numSamples : 0.0f;
-    const float lowAvg = juce::jlimit(0.0f, 1.5f, lowAccum * invSamples);
-    const float midAvg = juce::jlimit(0.0f, 1.5f, midAccum * invSamples);
-    const float highAvg = juce::jlimit(0.0f, 1.5f, highAccum * invSamples);
-    const float peak = juce::jlimit(0.0f, 1.2f, blockPeak);
-    const float delayEnergy = juce::jlimit(0.0f, 1.0f, juce::jmap(delayFeedback, 0.05f, 0.88f, 0.0f, 1.0f));
+    // Sample-and-hold plus quantise. Oversampled, the hold length is scaled
+    // up so the crushed rate stays the same in seconds.
+    float* osL = left;
+    float* osR = right;
 
-    auto smoothValue = [](float current, float target, float attack, float release)
+    if (factor > 1)
     {
-        const float coeff = target > current ? attack : release;
-        return current + (target - current) * coeff;
-    };
+        osL = crushOversampledL.data();
+        osR = crushOversampledR.data();
+        crushOversampler.upsample(crushOversampleState[0], left, osL, numSamples);
+        if (stereoPass)
+            crushOversampler.upsample(crushOversampleState[1], right, osR, numSamples);
+    }
 
-    meterSmoother = smoothValue(meterSmoother, peak, 0.45f, 0.08f);
-    lowBandSmoother = smoothValue(lowBandSmoother, lowAvg, 0.3f, 0.05f);
-    midBandSmoother = smoothValue(midBandSmoother, midAvg, 0.25f, 0.05f);
-    highBandSmoother = smoothValue(highBandSmoother, highAvg, 0.2f, 0.04f);
-    delayVisualSmoother = smoothValue(delayVisualSmoother, delayEnergy, 0.2f, 0.06f);
-    glitchVisualSmoother = smoothValue(glitchVisualSmoother, glitchActivity, 0.35f, 0.08f);
-
-    smoothedLevel.store(meterSmoother);
-    lowBandLevel.store(lowBandSmoother);
-    midBandLevel.store(midBandSmoother);
-    highBandLevel.store(highBandSmoother);
-    delayFeedbackVisual.store(delayVisualSmoother);
-    glitchHoldVisual.store(glitchVisualSmoother);
-}
+    if (crushAmt > 0.0f)
+    {
+        const int holdSamples = juce::jmax(1, (int)std::round(juce::jmap(crushAmt, 0.0f, 1.0f, 1.0f, 32.0f))) * factor;
+        const float levels = juce::jmap(crushAmt, 0.0f, 1.0f, 2048.0f, 6.0f);
 
-void MainComponent::releaseResources()
-{
-    filterL.reset();
-    filterR.reset();
-    amplitudeEnvelope.reset();
-}
+        for (int i = 0; i < numSamples * factor; ++i)
+        {
+            if (crushCounter <= 0)
+            {
+                crushCounter = holdSamples;
+                crushHoldL = osL[i];
+                crushHoldR = stereoPass ? osR[i] : crushHoldL;
+            }
 
-int MainComponent::findZeroCrossingIndex(int searchSpan) const
-{
-    const int N = scopeBuffer.getNumSamples();
-    int idx = (scopeWritePos - searchSpan + N) % N;
+            float crushedL = std::round(crushHoldL * levels) / levels;
+            osL[i] = juce::jmap(crushAmt, 0.0f, 1.0f, osL[i], crushedL);
+
+            if (stereoPass)
+            {
+                float crushedR = std::round(crushHoldR * levels) / levels;
+                osR[i] = juce::jmap(crushAmt, 0.0f, 1.0f, osR[i], crushedR);
+            }
+
+            --crushCounter;
+        }
+    }
+    else
+    {
+        crushCounter = 0;
+    }
+
+    if (factor > 1)
+    {
+        crushOversampler.downsample(crushOversampleState[0], osL, left, numSamples);
+        if (stereoPass)
+            crushOversampler.downsample(crushOversampleState[1], osR, right, numSamples);
+    }
 
-    float prev = scopeBuffer.getSample(0, idx);
-    for (int s = 1; s < searchSpan; ++s)
+    if (stereoPass)
     {
-        const int i = (idx + s) % N;
-        const float cur = scopeBuffer.getSample(0, i);
-        if (prev < 0.0f && cur >= 0.0f)
-            return i;
-        prev = cur;
+        crushStereo = !(monoInput && crushHoldL == crushHoldR
+                        && std::memcmp(&crushOversampleState[0], &crushOversampleState[1],
+                                       sizeof(Oversampler::ChannelState)) == 0);
+    }
+    else
+    {
+        juce::FloatVectorOperations::copy(right, left, numSamples);
+        crushOversampleState[1] = crushOversampleState[0];
     }
-    return (scopeWritePos + 1) % N;
 }
 
-void MainComponent::paint(juce::Graphics& g)
+void MainComponent::applyDelay(float* left, float* right, int numSamples, float mix, float feedback) noexcept
 {
-    g.fillAll(juce::Colours::black);
+    using fvo = juce::FloatVectorOperations;
+
+    // The shortest delay is far longer than a chunk, so the whole chunk can be
+    // read out of the ring before any of it is written back.
+    if (mix <= 0.0f)
+    {
+        delayLine.write(0, left, numSamples);
+        delayLine.write(1, right, numSamples);
+        delayLine.advance(numSamples);
+        return;
+    }
 
-   
+    // A settled delay time reads at one whole-sample delay (straight copies);
+    // a gliding one interpolates sample by sample.
+    const float* times = smoothers.getBuffer(delayTimeParam);
+    const bool constantTime = smoothers.isBlockConstant(delayTimeParam);
 
-    if (!scopeRect.isEmpty())
+    auto readTap = [&](int channel, int tap, float scale, float* output)
     {
-        auto drawRect = scopeRect;
-        g.setColour(juce::Colours::white.withAlpha(0.08f));
-        g.drawRoundedRectangle(drawRect.toFloat(), 8.0f, 1.0f);
+        if (constantTime)
+        {
+            delayLine.read(channel, tap, times[0] * scale, output, numSamples);
+        }
+        else if (scale == 1.0f)
+        {
+            delayLine.read(channel, tap, times, output, numSamples);
+        }
+        else
+        {
+            fvo::copyWithMultiply(delayTimes.data(), times, scale, numSamples);
+            delayLine.read(channel, tap, delayTimes.data(), output, numSamples);
+        }
+    };
+
+    float* wetL = delayWetL.data();
+    float* wetR = delayWetR.data();
+    float* feedbackL = delayFeedbackL.data();
+    float* feedbackR = delayFeedbackR.data();
+
+    readTap(0, 0, 1.0f, wetL);
+    readTap(1, 0, 1.0f, wetR);
+
+    switch (delayMode)
+    {
+        case DelayMode::PingPong:
+            // Mono in on the left, and each channel feeds the other, so the
+            // repeats bounce from side to side.
+            fvo::copyWithMultiply(feedbackL, left, 0.5f, numSamples);
+            fvo::addWithMultiply(feedbackL, right, 0.5f, numSamples);
+            fvo::addWithMultiply(feedbackL, wetR, feedback, numSamples);
+            fvo::copyWithMultiply(feedbackR, wetL, feedback, numSamples);
+            break;
+
+        case DelayMode::MultiTap:
+        case DelayMode::Stereo:
+        default:
+            fvo::copy(feedbackL, left, numSamples);
+            fvo::addWithMultiply(feedbackL, wetL, feedback, numSamples);
+            fvo::copy(feedbackR, right, numSamples);
+            fvo::addWithMultiply(feedbackR, wetR, feedback, numSamples);
+            break;
+    }
 
-        g.setColour(juce::Colours::white.withAlpha(0.85f));
-        juce::Path p;
+    if (delayMode == DelayMode::MultiTap)
+    {
+        // Two extra taps at 1/3 and 2/3 of the time, heard but not fed back
+        static constexpr float tapScales[] = { 1.0f / 3.0f, 2.0f / 3.0f };
+        static constexpr float tapGains[] = { 0.35f, 0.5f };
+        float* tapWet = delayTapWet.data();
 
-        const int start = findZeroCrossingIndex(scopeBuffer.getNumSamples() / 2);
-        const int W = drawRect.getWidth();
-        const int N = scopeBuffer.getNumSamples();
-        const float H = (float)drawRect.getHeight();
-        const float Y0 = (float)drawRect.getY();
-        const int X0 = drawRect.getX();
+        fvo::multiply(wetL, 0.7f, numSamples);
+        fvo::multiply(wetR, 0.7f, numSamples);
 
-        for (int x = 0; x < W; ++x)
+        for (int tap = 0; tap < 2; ++tap)
         {
-            const int i = (start + x) % N;
-            const float s = scopeBuffer.getSample(0, i);
-            const float y = juce::jmap(s, -1.0f, 1.0f, Y0 + H, Y0);
-            if (x == 0) p.startNewSubPath((float)X0, y);
-            else p.lineTo((float)(X0 + x), y);
+            readTap(0, tap + 1, tapScales[tap], tapWet);
+            fvo::addWithMultiply(wetL, tapWet, tapGains[tap], numSamples);
+            readTap(1, tap + 1, tapScales[tap], tapWet);
+            fvo::addWithMultiply(wetR, tapWet, tapGains[tap], numSamples);
         }
-        g.strokePath(p, juce::PathStrokeType(2.f));
     }
+
+    delayLine.write(0, feedbackL, numSamples);
+    delayLine.write(1, feedbackR, numSamples);
+    delayLine.advance(numSamples);
+
+    fvo::multiply(left, 1.0f - mix, numSamples);
+    fvo::addWithMultiply(left, wetL, mix, numSamples);
+    fvo::multiply(right, 1.0f - mix, numSamples);
+    fvo::addWithMultiply(right, wetR, mix, numSamples);
+}
+
+int MainComponent::getLatencySamples() const noexcept
+{
+    return latencySamples.load();
+}
+
+void MainComponent::releaseResources()
+{
+    renderPool.stop();
+    analyser.stop();
+    voices.reset();
+}
+
+void MainComponent::paint(juce::Graphics& g)
+{
+    // Only the backdrop: the scope and visualiser are child components that
+    // repaint themselves when their data changes
+    g.fillAll(juce::Colours::black);
 }
 
 void MainComponent::timerCallback()
 {
-    captureWaveformSnapshot();
+    if (scope.acquire())
+    {
+        scopeView.setFrame(scope.getFrame());
+        captureWaveformSnapshot();
+    }
+
+    analyser.getLatestFrame(analysisFrame);
+    updateKeyboardDisplay();
+    updateOversampleLabel();
+
+    // The delay's visual energy follows the knob, so it's smoothed here
+    const float delay = params.get(Param::delay);
+    const float delayEnergy = juce::jlimit(0.0f, 1.0f, delay);
+    delayVisualSmoother += (delayEnergy - delayVisualSmoother) * (delayEnergy > delayVisualSmoother ? 0.2f : 0.06f);
 
     if (oscVisualizer)
     {
+        oscVisualizer->setSpectrum(analysisFrame.spectrum.data(), AudioAnalyser::numSpectrumBands, analysisFrame.rms);
         oscVisualizer->setVisualData(
-            smoothedLevel.load(),
-            lowBandLevel.load(),
-            midBandLevel.load(),
-            highBandLevel.load(),
-            delayFeedbackVisual.load(),
-            glitchHoldVisual.load(),
-            driveAmount,
-            delayAmount,
-            chaosAmount,
-            waveformSnapshot
+            analysisFrame.peak,
+            analysisFrame.lowBand,
+            analysisFrame.midBand,
+            analysisFrame.highBand,
+            delayVisualSmoother,
+            analysisFrame.glitch,
+            params.get(Param::drive),
+            delay,
+            params.get(Param::chaos)
         );
     }
-
-    repaint();
 }
 
 
-void MainComponent::captureWaveformSnapshot()
+// The latency half lags the knob until the audio thread applies the new factor
+void MainComponent::updateOversampleLabel()
 {
-    const int numSamples = scopeBuffer.getNumSamples();
-    if (numSamples <= 0)
+    const int latency = getLatencySamples();
+    if (latency == shownLatencySamples)
         return;
 
-    const int resolution = 160;
-    const int start = findZeroCrossingIndex(numSamples / 2);
-    const int step = juce::jmax(1, numSamples / resolution);
+    shownLatencySamples = latency;
+    oversampleValue.setText(juce::String(1 << (int)oversampleKnob.getValue()) + "x / "
+        + juce::String(latency) + " smp", juce::dontSendNotification);
+}
 
-    std::vector<float> snapshot;
-    snapshot.reserve((size_t)resolution);
+void MainComponent::captureWaveformSnapshot()
+{
+    if (!oscVisualizer)
+        return;
 
-    for (int i = 0; i < resolution; ++i)
-    {
-        const int idx = (start + i * step) % numSamples;
-        snapshot.push_back(scopeBuffer.getSample(0, idx));
-    }
+    const auto& frame = scope.getFrame().samples;
+    auto& snapshot = oscVisualizer->beginSnapshot();
+    snapshot.size = oscVisualizer->getSnapshotResolution();
+
+    // Spread the points over the whole frame, whatever the resolution
+    const float step = (float)ScopeCapture::frameSize / (float)snapshot.size;
+    for (int i = 0; i < snapshot.size; ++i)
+        snapshot.points[(size_t)i] = frame[(size_t)((float)i * step)];
 
-    waveformSnapshot = std::move(snapshot);
+    oscVisualizer->commitSnapshot();
 }
 
 // ✅ FINAL DEFINITIVE FIX FOR ALL JUCE VERSIONS ✅
@@ -690,11 +830,10 @@ void MainComponent::resized()
 
     auto strip = area.removeFromTop(controlStripHeight);
     const int knob = knobSize;
-    const int numKnobs = 23;
-    const int colWidth = strip.getWidth() / numKnobs;
+    const int colWidth = strip.getWidth() / knobsPerRow;
 
     struct Item { juce::Label* L; juce::Slider* S; juce::Label* V; };
-    Item items[numKnobs] = {
+    Item items[numStripKnobs] = {
         { &waveLabel, &waveKnob, &waveValue },
         { &gainLabel, &gainKnob, &gainValue },
         { &attackLabel, &attackKnob, &attackValue },
@@ -704,6 +843,7 @@ void MainComponent::resized()
         { &pitchLabel, &pitchKnob, &pitchValue },
         { &cutoffLabel, &cutoffKnob, &cutoffValue },
         { &resonanceLabel, &resonanceKnob, &resonanceValue },
+        { &filterTypeLabel, &filterTypeKnob, &filterTypeValue },
         { &releaseLabel, &releaseKnob, &releaseValue },
         { &lfoLabel, &lfoKnob, &lfoValue },
         { &lfoDepthLabel, &lfoDepthKnob, &lfoDepthValue },
@@ -716,19 +856,27 @@ void MainComponent::resized()
         { &envFilterLabel, &envFilterKnob, &envFilterValue },
         { &chaosLabel, &chaosKnob, &chaosValueLabel },
         { &delayLabel, &delayKnob, &delayValue },
+        { &delayModeLabel, &delayModeKnob, &delayModeValue },
         { &autoPanLabel, &autoPanKnob, &autoPanValue },
-        { &glitchLabel, &glitchKnob, &glitchValue }
+        { &glitchLabel, &glitchKnob, &glitchValue },
+        { &unisonLabel, &unisonKnob, &unisonValue },
+        { &unisonSpreadLabel, &unisonSpreadKnob, &unisonSpreadValue },
+        { &unisonStereoLabel, &unisonStereoKnob, &unisonStereoValue },
+        { &oversampleLabel, &oversampleKnob, &oversampleValue },
+        { &partialsLabel, &partialsKnob, &partialsValue }
     };
 
     const int labelH = 14;
     const int valueH = 14;
-    const int labelY = strip.getY();
-    const int knobY = labelY + labelH + 2;
-    const int valueY = knobY + knob + 2;
 
-    for (int i = 0; i < numKnobs; ++i)
+    for (int i = 0; i < numStripKnobs; ++i)
     {
-        const int x = strip.getX() + i * colWidth + (colWidth - knob) / 2;
+        const int row = i / knobsPerRow;
+        const int x = strip.getX() + (i % knobsPerRow) * colWidth + (colWidth - knob) / 2;
+        const int labelY = strip.getY() + row * knobRowHeight;
+        const int knobY = labelY + labelH + 2;
+        const int valueY = knobY + knob + 2;
+
         items[i].L->setBounds(x, labelY, knob, labelH);
         items[i].S->setBounds(x, knobY, knob, knob);
         items[i].V->setBounds(x, valueY, knob, valueH);
@@ -767,7 +915,7 @@ void MainComponent::resized()
     else
         scopeArea = {};
 
-    scopeRect = scopeArea.isEmpty() ? juce::Rectangle<int>() : scopeArea.reduced(8, 6);
+    scopeView.setBounds(scopeArea.isEmpty() ? juce::Rectangle<int>() : scopeArea.reduced(8, 6));
 
     if (oscVisualizer)
         oscVisualizer->setBounds(area.reduced(12, 12));
@@ -874,8 +1022,10 @@ void MainComponent::initialiseSliders()
     configureValueLabel(waveValue);
     waveKnob.onValueChange = [this]
     {
-        waveMorph = (float)waveKnob.getValue();
-        waveValue.setText(juce::String(waveMorph, 2), juce::dontSendNotification);
+        const float morph = (float)waveKnob.getValue();
+        params.set(Param::waveMorph, morph);
+        waveValue.setText(juce::String(morph, 2), juce::dontSendNotification);
+        updateWavetableShape();
     };
     waveKnob.onValueChange();
 
@@ -887,9 +1037,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(gainValue);
     gainKnob.onValueChange = [this]
     {
-        outputGain = (float)gainKnob.getValue();
-        gainSmoothed.setTargetValue(outputGain);
-        gainValue.setText(juce::String(outputGain * 100.0f, 0) + "%", juce::dontSendNotification);
+        const float gain = (float)gainKnob.getValue();
+        params.set(Param::gain, gain);
+        gainValue.setText(juce::String(gain * 100.0f, 0) + "%", juce::dontSendNotification);
     };
     gainKnob.onValueChange();
 
@@ -902,9 +1052,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(attackValue);
     attackKnob.onValueChange = [this]
     {
-        attackMs = (float)attackKnob.getValue();
-        attackValue.setText(juce::String(attackMs, 0) + " ms", juce::dontSendNotification);
-        updateAmplitudeEnvelope();
+        const float ms = (float)attackKnob.getValue();
+        params.set(Param::attack, ms);
+        attackValue.setText(juce::String(ms, 0) + " ms", juce::dontSendNotification);
     };
     attackKnob.onValueChange();
 
@@ -917,9 +1067,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(decayValue);
     decayKnob.onValueChange = [this]
     {
-        decayMs = (float)decayKnob.getValue();
-        decayValue.setText(juce::String(decayMs, 0) + " ms", juce::dontSendNotification);
-        updateAmplitudeEnvelope();
+        const float ms = (float)decayKnob.getValue();
+        params.set(Param::decay, ms);
+        decayValue.setText(juce::String(ms, 0) + " ms", juce::dontSendNotification);
     };
     decayKnob.onValueChange();
 
@@ -931,9 +1081,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(sustainValue);
     sustainKnob.onValueChange = [this]
     {
-        sustainLevel = (float)sustainKnob.getValue();
-        sustainValue.setText(juce::String(sustainLevel * 100.0f, 0) + "%", juce::dontSendNotification);
-        updateAmplitudeEnvelope();
+        const float level = (float)sustainKnob.getValue();
+        params.set(Param::sustain, level);
+        sustainValue.setText(juce::String(level * 100.0f, 0) + "%", juce::dontSendNotification);
     };
     sustainKnob.onValueChange();
 
@@ -945,9 +1095,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(widthValue);
     widthKnob.onValueChange = [this]
     {
-        stereoWidth = (float)widthKnob.getValue();
-        stereoWidthSmoothed.setTargetValue(stereoWidth);
-        widthValue.setText(juce::String(stereoWidth, 2) + "x", juce::dontSendNotification);
+        const float width = (float)widthKnob.getValue();
+        params.set(Param::width, width);
+        widthValue.setText(juce::String(width, 2) + "x", juce::dontSendNotification);
     };
     widthKnob.onValueChange();
 
@@ -960,8 +1110,10 @@ void MainComponent::initialiseSliders()
     configureValueLabel(pitchValue);
     pitchKnob.onValueChange = [this]
     {
-        setTargetFrequency((float)pitchKnob.getValue());
-        pitchValue.setText(juce::String(targetFrequency, 1) + " Hz", juce::dontSendNotification);
+        // Picked up by the audio thread, which glides the newest voice to it
+        const float frequency = juce::jlimit(20.0f, 20000.0f, (float)pitchKnob.getValue());
+        params.set(Param::pitch, frequency);
+        pitchValue.setText(juce::String(frequency, 1) + " Hz", juce::dontSendNotification);
     };
     pitchKnob.onValueChange();
 
@@ -974,10 +1126,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(cutoffValue);
     cutoffKnob.onValueChange = [this]
     {
-        cutoffHz = (float)cutoffKnob.getValue();
-        cutoffSmoothed.setTargetValue(cutoffHz);
-        cutoffValue.setText(juce::String(cutoffHz, 1) + " Hz", juce::dontSendNotification);
-        filterUpdateCount = filterUpdateStep;
+        const float hz = (float)cutoffKnob.getValue();
+        params.set(Param::cutoff, hz);
+        cutoffValue.setText(juce::String(hz, 1) + " Hz", juce::dontSendNotification);
     };
     cutoffKnob.onValueChange();
 
@@ -990,14 +1141,26 @@ void MainComponent::initialiseSliders()
     configureValueLabel(resonanceValue);
     resonanceKnob.onValueChange = [this]
     {
-        resonanceQ = (float)resonanceKnob.getValue();
-        if (resonanceQ < 0.1f) resonanceQ = 0.1f;
-        resonanceSmoothed.setTargetValue(resonanceQ);
-        resonanceValue.setText(juce::String(resonanceQ, 2), juce::dontSendNotification);
-        filterUpdateCount = filterUpdateStep;
+        const float q = juce::jmax(0.1f, (float)resonanceKnob.getValue());
+        params.set(Param::resonance, q);
+        resonanceValue.setText(juce::String(q, 2), juce::dontSendNotification);
     };
     resonanceKnob.onValueChange();
 
+    configureRotarySlider(filterTypeKnob);
+    filterTypeKnob.setRange(0.0, (double)(StateVariableFilter::numModes - 1), 1.0);
+    filterTypeKnob.setValue((double)filterMode);
+    addAndMakeVisible(filterTypeKnob);
+    configureCaptionLabel(filterTypeLabel, "Filter Type");
+    configureValueLabel(filterTypeValue);
+    filterTypeKnob.onValueChange = [this]
+    {
+        const int mode = (int)filterTypeKnob.getValue();
+        params.set(Param::filterType, (float)mode);
+        filterTypeValue.setText(StateVariableFilter::getModeName((StateVariableFilter::Mode)mode), juce::dontSendNotification);
+    };
+    filterTypeKnob.onValueChange();
+
     configureRotarySlider(releaseKnob);
     releaseKnob.setRange(1.0, 4000.0, 1.0);
     releaseKnob.setSkewFactorFromMidPoint(200.0);
@@ -1007,9 +1170,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(releaseValue);
     releaseKnob.onValueChange = [this]
     {
-        releaseMs = (float)releaseKnob.getValue();
-        releaseValue.setText(juce::String(releaseMs, 0) + " ms", juce::dontSendNotification);
-        updateAmplitudeEnvelope();
+        const float ms = (float)releaseKnob.getValue();
+        params.set(Param::release, ms);
+        releaseValue.setText(juce::String(ms, 0) + " ms", juce::dontSendNotification);
     };
     releaseKnob.onValueChange();
 
@@ -1021,8 +1184,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(lfoValue);
     lfoKnob.onValueChange = [this]
     {
-        lfoRateHz = (float)lfoKnob.getValue();
-        lfoValue.setText(juce::String(lfoRateHz, 2) + " Hz", juce::dontSendNotification);
+        const float hz = (float)lfoKnob.getValue();
+        params.set(Param::lfoRate, hz);
+        lfoValue.setText(juce::String(hz, 2) + " Hz", juce::dontSendNotification);
     };
     lfoKnob.onValueChange();
 
@@ -1034,9 +1198,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(lfoDepthValue);
     lfoDepthKnob.onValueChange = [this]
     {
-        lfoDepth = (float)lfoDepthKnob.getValue();
-        lfoDepthSmoothed.setTargetValue(lfoDepth);
-        lfoDepthValue.setText(juce::String(lfoDepth, 2), juce::dontSendNotification);
+        const float depth = (float)lfoDepthKnob.getValue();
+        params.set(Param::lfoDepth, depth);
+        lfoDepthValue.setText(juce::String(depth, 2), juce::dontSendNotification);
     };
     lfoDepthKnob.onValueChange();
 
@@ -1048,8 +1212,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(filterModValue);
     filterModKnob.onValueChange = [this]
     {
-        lfoCutModAmt = (float)filterModKnob.getValue();
-        filterModValue.setText(juce::String(lfoCutModAmt, 2), juce::dontSendNotification);
+        const float amount = (float)filterModKnob.getValue();
+        params.set(Param::filterMod, amount);
+        filterModValue.setText(juce::String(amount, 2), juce::dontSendNotification);
     };
     filterModKnob.onValueChange();
 
@@ -1062,10 +1227,8 @@ void MainComponent::initialiseSliders()
     lfoModeKnob.onValueChange = [this]
     {
         const bool freeRun = juce::approximatelyEqual(lfoModeKnob.getValue(), 1.0);
-        lfoTriggerMode = freeRun ? LfoTriggerMode::FreeRun : LfoTriggerMode::Retrigger;
+        params.set(Param::lfoMode, freeRun ? 1.0f : 0.0f);
         lfoModeValue.setText(freeRun ? "Loop" : "Retrig", juce::dontSendNotification);
-        if (!freeRun)
-            triggerLfo();
     };
     lfoModeKnob.onValueChange();
 
@@ -1077,10 +1240,10 @@ void MainComponent::initialiseSliders()
     configureValueLabel(lfoStartValue);
     lfoStartKnob.onValueChange = [this]
     {
-        lfoStartPhaseNormalized = (float)lfoStartKnob.getValue();
-        const int degrees = juce::roundToInt(lfoStartPhaseNormalized * 360.0);
+        const float phase = (float)lfoStartKnob.getValue();
+        params.set(Param::lfoStart, phase);
+        const int degrees = juce::roundToInt(phase * 360.0);
         lfoStartValue.setText(juce::String(degrees) + juce::String::charToString(0x00B0), juce::dontSendNotification);
-        triggerLfo();
     };
     lfoStartKnob.onValueChange();
 
@@ -1092,9 +1255,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(driveValue);
     driveKnob.onValueChange = [this]
     {
-        driveAmount = (float)driveKnob.getValue();
-        driveSmoothed.setTargetValue(driveAmount);
-        driveValue.setText(juce::String(driveAmount, 2), juce::dontSendNotification);
+        const float amount = (float)driveKnob.getValue();
+        params.set(Param::drive, amount);
+        driveValue.setText(juce::String(amount, 2), juce::dontSendNotification);
     };
     driveKnob.onValueChange();
 
@@ -1106,8 +1269,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(crushValue);
     crushKnob.onValueChange = [this]
     {
-        crushAmount = (float)crushKnob.getValue();
-        crushValue.setText(juce::String(crushAmount * 100.0f, 0) + "%", juce::dontSendNotification);
+        const float amount = (float)crushKnob.getValue();
+        params.set(Param::crush, amount);
+        crushValue.setText(juce::String(amount * 100.0f, 0) + "%", juce::dontSendNotification);
     };
     crushKnob.onValueChange();
 
@@ -1119,8 +1283,10 @@ void MainComponent::initialiseSliders()
     configureValueLabel(subMixValue);
     subMixKnob.onValueChange = [this]
     {
-        subMixAmount = (float)subMixKnob.getValue();
-        subMixValue.setText(juce::String(subMixAmount * 100.0f, 0) + "%", juce::dontSendNotification);
+        const float amount = (float)subMixKnob.getValue();
+        params.set(Param::subMix, amount);
+        subMixValue.setText(juce::String(amount * 100.0f, 0) + "%", juce::dontSendNotification);
+        updateWavetableShape();
     };
     subMixKnob.onValueChange();
 
@@ -1132,8 +1298,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(envFilterValue);
     envFilterKnob.onValueChange = [this]
     {
-        envFilterAmount = (float)envFilterKnob.getValue();
-        envFilterValue.setText(juce::String(envFilterAmount, 2), juce::dontSendNotification);
+        const float amount = (float)envFilterKnob.getValue();
+        params.set(Param::envFilter, amount);
+        envFilterValue.setText(juce::String(amount, 2), juce::dontSendNotification);
     };
     envFilterKnob.onValueChange();
 
@@ -1145,8 +1312,10 @@ void MainComponent::initialiseSliders()
     configureValueLabel(chaosValueLabel);
     chaosKnob.onValueChange = [this]
     {
-        chaosAmount = (float)chaosKnob.getValue();
-        chaosValueLabel.setText(juce::String(chaosAmount * 100.0f, 0) + "%", juce::dontSendNotification);
+        const float amount = (float)chaosKnob.getValue();
+        params.set(Param::chaos, amount);
+        chaosValueLabel.setText(juce::String(amount * 100.0f, 0) + "%", juce::dontSendNotification);
+        updateWavetableShape();
     };
     chaosKnob.onValueChange();
 
@@ -1158,11 +1327,27 @@ void MainComponent::initialiseSliders()
     configureValueLabel(delayValue);
     delayKnob.onValueChange = [this]
     {
-        delayAmount = (float)delayKnob.getValue();
-        delayValue.setText(juce::String(delayAmount * 100.0f, 0) + "%", juce::dontSendNotification);
+        const float amount = (float)delayKnob.getValue();
+        params.set(Param::delay, amount);
+        delayValue.setText(juce::String(amount * 100.0f, 0) + "%", juce::dontSendNotification);
     };
     delayKnob.onValueChange();
 
+    configureRotarySlider(delayModeKnob);
+    delayModeKnob.setRange(0.0, 2.0, 1.0);
+    delayModeKnob.setValue((double)(int)delayMode);
+    addAndMakeVisible(delayModeKnob);
+    configureCaptionLabel(delayModeLabel, "Delay Mode");
+    configureValueLabel(delayModeValue);
+    delayModeKnob.onValueChange = [this]
+    {
+        static const char* const names[] = { "Stereo", "Ping-Pong", "Multi-Tap" };
+        const int mode = juce::jlimit(0, 2, juce::roundToInt(delayModeKnob.getValue()));
+        params.set(Param::delayMode, (float)mode);
+        delayModeValue.setText(names[mode], juce::dontSendNotification);
+    };
+    delayModeKnob.onValueChange();
+
     configureRotarySlider(autoPanKnob);
     autoPanKnob.setRange(0.0, 1.0);
     autoPanKnob.setValue(autoPanAmount);
@@ -1171,8 +1356,9 @@ void MainComponent::initialiseSliders()
     configureValueLabel(autoPanValue);
     autoPanKnob.onValueChange = [this]
     {
-        autoPanAmount = (float)autoPanKnob.getValue();
-        autoPanValue.setText(juce::String(autoPanAmount * 100.0f, 0) + "%", juce::dontSendNotification);
+        const float amount = (float)autoPanKnob.getValue();
+        params.set(Param::autoPan, amount);
+        autoPanValue.setText(juce::String(amount * 100.0f, 0) + "%", juce::dontSendNotification);
     };
     autoPanKnob.onValueChange();
 
@@ -1184,10 +1370,83 @@ void MainComponent::initialiseSliders()
     configureValueLabel(glitchValue);
     glitchKnob.onValueChange = [this]
     {
-        glitchProbability = (float)glitchKnob.getValue();
-        glitchValue.setText(juce::String(glitchProbability * 100.0f, 0) + "%", juce::dontSendNotification);
+        const float probability = (float)glitchKnob.getValue();
+        params.set(Param::glitch, probability);
+        glitchValue.setText(juce::String(probability * 100.0f, 0) + "%", juce::dontSendNotification);
     };
     glitchKnob.onValueChange();
+
+    configureRotarySlider(unisonKnob);
+    unisonKnob.setRange(1.0, (double)VoiceEngine::maxUnison, 1.0);
+    unisonKnob.setValue(unisonVoices);
+    addAndMakeVisible(unisonKnob);
+    configureCaptionLabel(unisonLabel, "Unison");
+    configureValueLabel(unisonValue);
+    unisonKnob.onValueChange = [this]
+    {
+        const int copies = (int)unisonKnob.getValue();
+        params.set(Param::unison, (float)copies);
+        unisonValue.setText(juce::String(copies) + "x", juce::dontSendNotification);
+    };
+    unisonKnob.onValueChange();
+
+    configureRotarySlider(unisonSpreadKnob);
+    unisonSpreadKnob.setRange(0.0, 1.0);
+    unisonSpreadKnob.setValue(unisonSpread);
+    addAndMakeVisible(unisonSpreadKnob);
+    configureCaptionLabel(unisonSpreadLabel, "Detune");
+    configureValueLabel(unisonSpreadValue);
+    unisonSpreadKnob.onValueChange = [this]
+    {
+        const float spread = (float)unisonSpreadKnob.getValue();
+        params.set(Param::unisonSpread, spread);
+        unisonSpreadValue.setText(juce::String(spread * 100.0f, 0) + "%", juce::dontSendNotification);
+    };
+    unisonSpreadKnob.onValueChange();
+
+    configureRotarySlider(unisonStereoKnob);
+    unisonStereoKnob.setRange(0.0, 1.0);
+    unisonStereoKnob.setValue(unisonStereo);
+    addAndMakeVisible(unisonStereoKnob);
+    configureCaptionLabel(unisonStereoLabel, "Uni Stereo");
+    configureValueLabel(unisonStereoValue);
+    unisonStereoKnob.onValueChange = [this]
+    {
+        const float stereo = (float)unisonStereoKnob.getValue();
+        params.set(Param::unisonStereo, stereo);
+        unisonStereoValue.setText(juce::String(stereo * 100.0f, 0) + "%", juce::dontSendNotification);
+    };
+    unisonStereoKnob.onValueChange();
+
+    configureRotarySlider(oversampleKnob);
+    oversampleKnob.setRange(0.0, (double)Oversampler::maxFactorLog2, 1.0);
+    oversampleKnob.setValue(oversamplingLog2);
+    addAndMakeVisible(oversampleKnob);
+    configureCaptionLabel(oversampleLabel, "Oversample");
+    configureValueLabel(oversampleValue);
+    oversampleKnob.onValueChange = [this]
+    {
+        const int factorLog2 = (int)oversampleKnob.getValue();
+        params.set(Param::oversampling, (float)factorLog2);
+        shownLatencySamples = -1;
+        updateOversampleLabel();
+    };
+    oversampleKnob.onValueChange();
+
+    configureRotarySlider(partialsKnob);
+    partialsKnob.setRange(1.0, (double)WavetableOscillator::maxPartialLimit, 1.0);
+    partialsKnob.setValue(WavetableOscillator::defaultMaxPartials);
+    addAndMakeVisible(partialsKnob);
+    configureCaptionLabel(partialsLabel, "Partials");
+    configureValueLabel(partialsValue);
+    partialsKnob.onValueChange = [this]
+    {
+        const int partials = (int)partialsKnob.getValue();
+        params.set(Param::partials, (float)partials);
+        partialsValue.setText(juce::String(partials), juce::dontSendNotification);
+        updateWavetableShape();
+    };
+    partialsKnob.onValueChange();
 }
 
 void MainComponent::initialiseToggle()
@@ -1196,15 +1455,11 @@ void MainComponent::initialiseToggle()
     audioToggle.setToggleState(true, juce::dontSendNotification);
     audioToggle.onClick = [this]
     {
-        audioEnabled = audioToggle.getToggleState();
-        audioToggle.setButtonText(audioEnabled ? "Audio ON" : "Audio OFF");
-        if (!audioEnabled)
-        {
-            midiGate = false;
-            amplitudeEnvelope.noteOff();
-        }
+        const bool enabled = audioToggle.getToggleState();
+        params.set(Param::audioEnabled, enabled ? 1.0f : 0.0f);
+        audioToggle.setButtonText(enabled ? "Audio ON" : "Audio OFF");
     };
-    audioToggle.setButtonText("Audio ON");
+    audioToggle.onClick();
     addAndMakeVisible(audioToggle);
 }
 
@@ -1261,90 +1516,315 @@ void MainComponent::updateAmplitudeEnvelope()
     ampEnvParams.decay = juce::jlimit(0.0005f, 20.0f, decayMs * 0.001f);
     ampEnvParams.sustain = juce::jlimit(0.0f, 1.0f, sustainLevel);
     ampEnvParams.release = juce::jlimit(0.0005f, 20.0f, releaseMs * 0.001f);
-    amplitudeEnvelope.setParameters(ampEnvParams);
+    voices.setEnvelope(ampEnvParams);
 }
 
 void MainComponent::triggerLfo()
 {
     if (lfoTriggerMode == LfoTriggerMode::Retrigger)
     {
-        const float wrapped = juce::jlimit(0.0f, 1.0f, lfoStartPhaseNormalized);
-        lfoPhase = juce::MathConstants<float>::twoPi * wrapped;
-        while (lfoPhase >= juce::MathConstants<float>::twoPi)
-            lfoPhase -= juce::MathConstants<float>::twoPi;
-        if (lfoPhase < 0.0f)
-            lfoPhase += juce::MathConstants<float>::twoPi;
+        lfoPhase.setNormalised(juce::jlimit(0.0f, 1.0f, lfoStartPhaseNormalized));
     }
 }
 
 //==============================================================================
-// MIDI Input handlers stay unchanged
+// MIDI input: hardware arrives on the MIDI thread, the on-screen keyboard on
+// the message thread. Neither touches the voices; both just queue the note
+// with its arrival time for the audio thread.
 void MainComponent::handleIncomingMidiMessage(juce::MidiInput*, const juce::MidiMessage& m)
 {
-    if (m.isNoteOn())
-    {
-        const auto noteNumber = m.getNoteNumber();
-        noteStack.addIfNotAlreadyThere(noteNumber);
-        currentMidiNote = noteNumber;
-        currentVelocity = juce::jlimit(0.0f, 1.0f, m.getVelocity() / 127.0f);
-        setTargetFrequency(midiNoteToFreq(currentMidiNote));
-        midiGate = true;
-        amplitudeEnvelope.noteOn();
-        triggerLfo();
+    // AudioDeviceManager serialises these callbacks across devices, so this
+    // is the queue's only producer
+    TimedNoteEvent timed;
+    if (toNoteEvent(m, timed.event))
+    {
+        timed.arrivalMs = juce::Time::getMillisecondCounterHiRes();
+        midiInputQueue.push(&timed, 1);
     }
-    else if (m.isNoteOff())
+}
+
+void MainComponent::handleNoteOn(juce::MidiKeyboardState*, int, int midiNoteNumber, float velocity)
+{
+    if (updatingKeyboardDisplay)
+        return;
+
+    TimedNoteEvent timed;
+    timed.arrivalMs = juce::Time::getMillisecondCounterHiRes();
+    timed.event.type = BlockEvent::noteOn;
+    timed.event.midiNote = midiNoteNumber;
+    timed.event.velocity = juce::jlimit(0.0f, 1.0f, velocity);
+    keyboardQueue.push(&timed, 1);
+}
+
+void MainComponent::handleNoteOff(juce::MidiKeyboardState*, int, int midiNoteNumber, float)
+{
+    if (updatingKeyboardDisplay)
+        return;
+
+    TimedNoteEvent timed;
+    timed.arrivalMs = juce::Time::getMillisecondCounterHiRes();
+    timed.event.type = BlockEvent::noteOff;
+    timed.event.midiNote = midiNoteNumber;
+    keyboardQueue.push(&timed, 1);
+}
+
+void MainComponent::updateKeyboardDisplay()
+{
+    // Light the keys for notes the audio thread played from the roll or
+    // hardware, without feeding them back into keyboardQueue
+    const int count = keyboardDisplayQueue.pop(displayedNotes.data(), (int)displayedNotes.size());
+
+    const juce::ScopedValueSetter<bool> echoing(updatingKeyboardDisplay, true);
+
+    for (int i = 0; i < count; ++i)
     {
-        noteStack.removeFirstMatchingValue(m.getNoteNumber());
-        if (noteStack.isEmpty())
-        {
-            midiGate = false;
-            currentMidiNote = -1;
-            amplitudeEnvelope.noteOff();
-        }
-        else
+        const auto& event = displayedNotes[(size_t)i];
+
+        switch (event.type)
         {
-            currentMidiNote = noteStack.getLast();
-            setTargetFrequency(midiNoteToFreq(currentMidiNote));
-            midiGate = true;
-            amplitudeEnvelope.noteOn();
-            triggerLfo();
+            case BlockEvent::noteOn:
+                keyboardState.noteOn(1, event.midiNote, event.velocity);
+                break;
+
+            case BlockEvent::noteOff:
+                keyboardState.noteOff(1, event.midiNote, 0.0f);
+                break;
+
+            case BlockEvent::allNotesOff:
+                keyboardState.allNotesOff(1);
+                break;
+
+            case BlockEvent::parameterChange:
+                break;
         }
     }
-    else if (m.isAllNotesOff() || m.isAllSoundOff())
+}
+
+//==============================================================================
+// Block events (audio thread)
+bool MainComponent::toNoteEvent(const juce::MidiMessage& message, BlockEvent& event) noexcept
+{
+    if (message.isNoteOn())
+    {
+        event.type = BlockEvent::noteOn;
+        event.midiNote = message.getNoteNumber();
+        event.velocity = juce::jlimit(0.0f, 1.0f, message.getFloatVelocity());
+        return true;
+    }
+
+    if (message.isNoteOff())
+    {
+        event.type = BlockEvent::noteOff;
+        event.midiNote = message.getNoteNumber();
+        return true;
+    }
+
+    if (message.isAllNotesOff() || message.isAllSoundOff())
     {
-        noteStack.clear();
-        midiGate = false;
-        currentMidiNote = -1;
-        amplitudeEnvelope.noteOff();
+        event.type = BlockEvent::allNotesOff;
+        return true;
     }
+
+    return false;
 }
 
-void MainComponent::handleNoteOn(juce::MidiKeyboardState*, int, int midiNoteNumber, float velocity)
+int MainComponent::getArrivalOffset(double arrivalMs, int numSamples, double blockStartMs) const noexcept
 {
-    noteStack.addIfNotAlreadyThere(midiNoteNumber);
-    currentMidiNote = midiNoteNumber;
-    currentVelocity = juce::jlimit(0.0f, 1.0f, velocity);
-    setTargetFrequency(midiNoteToFreq(currentMidiNote));
-    midiGate = true;
-    amplitudeEnvelope.noteOn();
-    triggerLfo();
+    // Anything that arrived during the previous block's worth of time is
+    // played back with the same spacing in this one: a constant one-block
+    // delay instead of everything snapping to the top of the block
+    const double samplesPerMs = currentSR * 0.001;
+    const double windowStartMs = blockStartMs - (double)numSamples / samplesPerMs;
+    return juce::jlimit(0, numSamples - 1, juce::roundToInt((arrivalMs - windowStartMs) * samplesPerMs));
 }
 
-void MainComponent::handleNoteOff(juce::MidiKeyboardState*, int, int midiNoteNumber, float)
+void MainComponent::drainParameterChanges(int numSamples, double blockStartMs) noexcept
 {
-    noteStack.removeFirstMatchingValue(midiNoteNumber);
-    if (noteStack.isEmpty())
+    // Dropped changes: the queue can't be replayed in order any more, so
+    // every value's latest state takes effect right away instead
+    if (params.consumeOverflow())
+        resyncParameters();
+
+    const int count = params.popChanges(drainedChanges.data(), maxBlockEvents - numBlockEvents);
+
+    for (int i = 0; i < count; ++i)
     {
-        midiGate = false;
-        currentMidiNote = -1;
-        amplitudeEnvelope.noteOff();
+        const auto& change = drainedChanges[(size_t)i];
+
+        BlockEvent event;
+        event.type = BlockEvent::parameterChange;
+        event.parameter = change.id;
+        event.value = change.value;
+        event.sampleOffset = getArrivalOffset(change.arrivalMs, numSamples, blockStartMs);
+        blockEvents[(size_t)numBlockEvents++] = event;
     }
-    else
+}
+
+void MainComponent::collectBlockEvents(const juce::MidiBuffer& midi, int numSamples) noexcept
+{
+    // MidiBuffer is already ordered by sample position. Collected first, so
+    // only a roll with more than maxBlockEvents notes in one block can lose any
+    for (const auto metadata : midi)
+    {
+        if (numBlockEvents >= maxBlockEvents)
+            break;
+
+        BlockEvent event;
+        if (!toNoteEvent(metadata.getMessage(), event))
+            continue;
+
+        event.sampleOffset = juce::jlimit(0, numSamples - 1, metadata.samplePosition);
+        blockEvents[(size_t)numBlockEvents++] = event;
+        keyboardDisplayQueue.push(&event, 1);
+    }
+}
+
+void MainComponent::drainNoteQueue(SpscRingBuffer<TimedNoteEvent>& queue, int numSamples,
+                                   double blockStartMs, bool display) noexcept
+{
+    const int count = queue.pop(drainedNotes.data(), maxBlockEvents - numBlockEvents);
+
+    for (int i = 0; i < count; ++i)
     {
-        currentMidiNote = noteStack.getLast();
-        setTargetFrequency(midiNoteToFreq(currentMidiNote));
-        midiGate = true;
-        amplitudeEnvelope.noteOn();
-        triggerLfo();
+        const auto& timed = drainedNotes[(size_t)i];
+        BlockEvent event = timed.event;
+        event.sampleOffset = getArrivalOffset(timed.arrivalMs, numSamples, blockStartMs);
+
+        blockEvents[(size_t)numBlockEvents++] = event;
+
+        if (display)
+            keyboardDisplayQueue.push(&event, 1);
+    }
+}
+
+void MainComponent::sortBlockEvents() noexcept
+{
+    // On the same sample a parameter change goes ahead of any note, so the
+    // note starts with the new value
+    auto comesBefore = [](const BlockEvent& a, const BlockEvent& b)
+    {
+        if (a.sampleOffset != b.sampleOffset)
+            return a.sampleOffset < b.sampleOffset;
+
+        return a.type == BlockEvent::parameterChange && b.type != BlockEvent::parameterChange;
+    };
+
+    // Insertion sort: the sources arrive already sorted and there are only a
+    // handful of events, and unlike std::stable_sort it never allocates.
+    // Stable, so a note-off and note-on on the same sample keep their order.
+    for (int i = 1; i < numBlockEvents; ++i)
+    {
+        const BlockEvent event = blockEvents[(size_t)i];
+        int j = i;
+
+        while (j > 0 && comesBefore(event, blockEvents[(size_t)(j - 1)]))
+        {
+            blockEvents[(size_t)j] = blockEvents[(size_t)(j - 1)];
+            --j;
+        }
+
+        blockEvents[(size_t)j] = event;
+    }
+}
+
+void MainComponent::applyBlockEvent(const BlockEvent& event) noexcept
+{
+    switch (event.type)
+    {
+        case BlockEvent::noteOn:
+            if (audioEnabled)
+            {
+                voices.noteOn(event.midiNote, event.velocity);
+                triggerLfo();
+            }
+            break;
+
+        case BlockEvent::noteOff:
+            voices.noteOff(event.midiNote);
+            break;
+
+        case BlockEvent::allNotesOff:
+            voices.releaseAll();
+            break;
+
+        case BlockEvent::parameterChange:
+            applyParameter(event.parameter, event.value);
+            break;
+    }
+}
+
+//==============================================================================
+// Parameters (audio thread, or prepareToPlay while the audio is stopped)
+void MainComponent::applyParameter(Param id, float value) noexcept
+{
+    switch (id)
+    {
+        case Param::gain:           outputGain = value;     smoothers.setTargetValue(gainParam, value); break;
+        case Param::width:          stereoWidth = value;    smoothers.setTargetValue(stereoWidthParam, value); break;
+        case Param::cutoff:         cutoffHz = value;       smoothers.setTargetValue(cutoffParam, value); break;
+        case Param::resonance:      resonanceQ = value;     smoothers.setTargetValue(resonanceParam, value); break;
+        case Param::lfoDepth:       lfoDepth = value;       smoothers.setTargetValue(lfoDepthParam, value); break;
+        case Param::drive:          driveAmount = value;    smoothers.setTargetValue(driveParam, value); break;
+
+        case Param::attack:         attackMs = value;       updateAmplitudeEnvelope(); break;
+        case Param::decay:          decayMs = value;        updateAmplitudeEnvelope(); break;
+        case Param::sustain:        sustainLevel = value;   updateAmplitudeEnvelope(); break;
+        case Param::release:        releaseMs = value;      updateAmplitudeEnvelope(); break;
+
+        case Param::pitch:          targetFrequency = value; break;
+        case Param::filterType:     filterMode = (StateVariableFilter::Mode)(int)value; break;
+        case Param::lfoRate:        lfoRateHz = value; break;
+        case Param::filterMod:      lfoCutModAmt = value; break;
+        case Param::crush:          crushAmount = value; break;
+        case Param::subMix:         subMixAmount = value; break;
+        case Param::envFilter:      envFilterAmount = value; break;
+        case Param::chaos:          chaosAmount = value; break;
+        case Param::delay:          delayAmount = value; break;
+        case Param::delayMode:      delayMode = (DelayMode)juce::jlimit(0, 2, (int)value); break;
+        case Param::autoPan:        autoPanAmount = value; break;
+        case Param::glitch:         glitchProbability = value; break;
+        case Param::unison:         unisonVoices = (int)value; break;
+        case Param::unisonSpread:   unisonSpread = value; break;
+        case Param::unisonStereo:   unisonStereo = value; break;
+        case Param::oversampling:   oversamplingLog2 = (int)value; break;
+
+        case Param::lfoMode:
+            lfoTriggerMode = value >= 0.5f ? LfoTriggerMode::FreeRun : LfoTriggerMode::Retrigger;
+            triggerLfo();
+            break;
+
+        case Param::lfoStart:
+            lfoStartPhaseNormalized = value;
+            triggerLfo();
+            break;
+
+        case Param::audioEnabled:
+            audioEnabled = value >= 0.5f;
+            if (!audioEnabled)
+                voices.releaseAll();
+            break;
+
+        // Wavetable shape: read from the bus when the tables are rebuilt on
+        // the message thread
+        case Param::waveMorph:
+        case Param::partials:
+        case Param::numParams:
+        default:
+            break;
     }
 }
+
+void MainComponent::resyncParameters() noexcept
+{
+    // Discard first: replaying older queued changes after the latest values
+    // would leave each parameter on a stale one
+    params.consumeOverflow();
+    params.discardChanges();
+    applyAllParameters();
+}
+
+void MainComponent::applyAllParameters() noexcept
+{
+    for (int i = 0; i < Parameters::numParams; ++i)
+        applyParameter((Param)i, params.get((Param)i));
+}
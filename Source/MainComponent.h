@@ -1,9 +1,25 @@
 #pragma once
 #include <JuceHeader.h>
 #include <vector>
+#include <array>
 #include <atomic>
+#include <utility>
 #include "MidiRollComponent.h"
 #include "OscVisualizerComponent.h"
+#include "WavetableOscillator.h"
+#include "VoiceEngine.h"
+#include "RealtimeThreadPool.h"
+#include "Oversampler.h"
+#include "SmootherBank.h"
+#include "StateVariableFilter.h"
+#include "DelayLine.h"
+#include "FastRandom.h"
+#include "AudioAnalyser.h"
+#include "ScopeCapture.h"
+#include "ScopeComponent.h"
+#include "SpscRingBuffer.h"
+#include "ParameterBus.h"
+#include "PhaseAccumulator.h"
 
 
 
@@ -13,13 +29,21 @@ class MainComponent : public juce::AudioAppComponent,
                       private juce::Timer
 {
 public:
-    MainComponent();
+    // With parallelVoices false the voices render on the audio thread alone
+    // and no worker threads are started.
+    explicit MainComponent(bool parallelVoices = true);
     ~MainComponent() override;
 
     void prepareToPlay(int, double) override;
     void getNextAudioBlock(const juce::AudioSourceChannelInfo&) override;
     void releaseResources() override;
 
+    // Processing delay, in samples at the device rate, that the oversampled
+    // voice drive and crush stages add to the output: the figure a host or
+    // device wrapper should compensate for. It follows the Oversample knob
+    // once the audio thread has applied the new factor. Any thread.
+    int getLatencySamples() const noexcept;
+
     void paint(juce::Graphics&) override;
     void resized() override;
 
@@ -29,12 +53,60 @@ public:
     void handleNoteOff(juce::MidiKeyboardState*, int midiChannel, int midiNoteNumber, float /*velocity*/) override;
 
 private:
+    // ===== Parameters =====
+    // Every knob and the audio toggle. The UI only ever writes these through
+    // the bus; the members below are the audio thread's own copies, updated
+    // when a change is applied at its offset in a block.
+    enum class Param
+    {
+        waveMorph = 0,
+        gain,
+        attack,
+        decay,
+        sustain,
+        width,
+        pitch,
+        cutoff,
+        resonance,
+        filterType,
+        release,
+        lfoRate,
+        lfoDepth,
+        filterMod,
+        lfoMode,
+        lfoStart,
+        drive,
+        crush,
+        subMix,
+        envFilter,
+        chaos,
+        delay,
+        delayMode,
+        autoPan,
+        glitch,
+        unison,
+        unisonSpread,
+        unisonStereo,
+        oversampling,
+        partials,
+        audioEnabled,
+        numParams
+    };
+
+    using Parameters = ParameterBus<Param, (int)Param::numParams>;
+    static constexpr int parameterQueueSize = 1024;
+
+    Parameters params;
+
     // ===== Synth state =====
-    float   phase = 0.0f;
     float   targetFrequency = 220.0f;
+    float   appliedPitchKnobFrequency = 220.0f;
+    VoiceEngine voices;
+    RealtimeThreadPool renderPool;    // spreads voice blocks across cores
+    const bool useRenderPool;
 
     // LFO (vibrato)
-    float   lfoPhase = 0.0f;
+    PhaseAccumulator lfoPhase;
     float   lfoRateHz = 5.0f;
     float   lfoDepth = 0.03f;
     float   lfoStartPhaseNormalized = 0.0f;
@@ -47,14 +119,16 @@ private:
 
     LfoTriggerMode lfoTriggerMode = LfoTriggerMode::Retrigger;
 
-    // Smoothed parameters for a more polished response
-    juce::SmoothedValue<float> frequencySmoothed;
-    juce::SmoothedValue<float> gainSmoothed;
-    juce::SmoothedValue<float> cutoffSmoothed;
-    juce::SmoothedValue<float> resonanceSmoothed;
-    juce::SmoothedValue<float> stereoWidthSmoothed;
-    juce::SmoothedValue<float> lfoDepthSmoothed;
-    juce::SmoothedValue<float> driveSmoothed;
+    // How the delay routes its taps and feedback
+    enum class DelayMode
+    {
+        Stereo = 0,
+        PingPong,
+        MultiTap
+    };
+
+    DelayMode delayMode = DelayMode::Stereo;
+
 
     // Output Gain
     float   outputGain = 0.5f;
@@ -67,15 +141,23 @@ private:
     float   autoPanAmount = 0.0f;
     float   glitchProbability = 0.0f;
 
-    // Filter (cutoff + resonance + per-channel IIR)
+    // Unison (copies per voice, detune spread, stereo spread)
+    int     unisonVoices = 1;
+    float   unisonSpread = 0.25f;
+    float   unisonStereo = 0.5f;
+
+    // Filter (cutoff + resonance + mode, one state-variable filter per voice)
     float   cutoffHz = 1000.0f;
     float   resonanceQ = 0.707f;
-    juce::IIRFilter filterL, filterR;
+    StateVariableFilter::Mode filterMode = StateVariableFilter::lowPass;
 
     float   lfoCutModAmt = 0.0f;
     float   chaosValue = 0.0f;
     int     chaosSamplesRemaining = 0;
-    juce::Random random;
+
+    // Drives the chaos steps and glitch holds. Reseeded on every
+    // prepareToPlay(), so a performance replays the same random events.
+    FastRandom random;
 
     // Envelope
     float   attackMs = 8.0f;
@@ -83,33 +165,125 @@ private:
     float   sustainLevel = 0.75f;
     float   releaseMs = 280.0f;
 
-    juce::ADSR amplitudeEnvelope;
     juce::ADSR::Parameters ampEnvParams;
 
     // Stereo width
     float   stereoWidth = 1.0f;
 
-    int filterUpdateStep = 16;
-    int filterUpdateCount = 0;
     double currentSR = 44100.0;
 
-    float waveMorph = 0.0f;
-    juce::AudioBuffer<float> scopeBuffer{ 1, 2048 };
-    int scopeWritePos = 0;
-    float subPhase = 0.0f;
-    float detunePhase = 0.0f;
-    float autoPanPhase = 0.0f;
+    // Rebuilt on the message thread from the bus's waveform, sub mix, chaos
+    // and partials values
+    WavetableOscillator wavetable;
+
+    // Per-chunk control buffers shared by every voice
+    static constexpr int renderChunkSize = VoiceEngine::maxChunkSize;
+    alignas(32) std::array<float, renderChunkSize> pitchModulation {};
+    alignas(32) std::array<float, renderChunkSize> lfoValues {};
+
+    // Smoothed parameters for a more polished response, ramped a chunk at a time
+    enum SmoothedParam
+    {
+        gainParam = 0,
+        cutoffParam,
+        resonanceParam,
+        stereoWidthParam,
+        lfoDepthParam,
+        driveParam,
+        delayTimeParam,
+        numSmoothedParams
+    };
+
+    SmootherBank<numSmoothedParams, renderChunkSize> smoothers;
+    alignas(32) std::array<float, renderChunkSize> voiceMixL {};
+    alignas(32) std::array<float, renderChunkSize> voiceMixR {};
+
+    ScopeCapture scope;
+    PhaseAccumulator autoPanPhase;
     float autoPanRateHz = 0.35f;
     int crushCounter = 0;
     float crushHoldL = 0.0f;
     float crushHoldR = 0.0f;
-    juce::AudioBuffer<float> delayBuffer{ 2, 1 };
-    int delayWritePosition = 0;
-    int maxDelaySamples = 1;
+    bool crushStereo = false;   // right crush state has diverged from the left
+
+    // Oversampling around the nonlinear stages (voice drive, crush)
+    int oversamplingLog2 = 0;
+    int appliedOversamplingLog2 = 0;
+    Oversampler crushOversampler;
+    std::atomic<int> latencySamples { 0 };          // published by applyOversampling()
+    int shownLatencySamples = -1;                   // what the Oversample label last showed
+    Oversampler::ChannelState crushOversampleState[2];
+    std::array<float, renderChunkSize * Oversampler::maxFactor> crushOversampledL {};
+    std::array<float, renderChunkSize * Oversampler::maxFactor> crushOversampledR {};
+    DelayLine delayLine;
+    alignas(32) std::array<float, renderChunkSize> delayTimes {};
+    alignas(32) std::array<float, renderChunkSize> delayWetL {};
+    alignas(32) std::array<float, renderChunkSize> delayWetR {};
+    alignas(32) std::array<float, renderChunkSize> delayTapWet {};
+    alignas(32) std::array<float, renderChunkSize> delayFeedbackL {};
+    alignas(32) std::array<float, renderChunkSize> delayFeedbackR {};
     int glitchSamplesRemaining = 0;
+    int glitchSamplesUntilNext = 0;                 // scheduled wait before the next hold
+    float glitchScheduledProbability = -1.0f;       // probability the wait was drawn for
     float glitchHeldL = 0.0f;
     float glitchHeldR = 0.0f;
 
+    // ===== Stage-specialised chunk rendering =====
+    // The per-sample loops after the settings are compiled once per
+    // combination of active stages, so a stage that's off costs nothing
+    // inside them, and the chunk dispatches once to the matching version.
+    // Chaos, auto-pan and glitch each carry a weight that ramps towards 1
+    // while the stage is on and towards 0 while it's off, taking
+    // stageCrossfadeSamples for a full swing. Every stage with a non-zero
+    // weight is rendered, so toggling again mid-fade turns the ramp around
+    // from wherever it had got to.
+    enum Stage
+    {
+        chaosStage      = 1 << 0,
+        autoPanStage    = 1 << 1,
+        glitchStage     = 1 << 2,
+        stereoOutput    = 1 << 3,
+        numStageMasks   = 1 << 4
+    };
+
+    static constexpr int numFadingStages = 3;       // the low bits: chaos, auto-pan, glitch
+    static_assert((chaosStage | autoPanStage | glitchStage) == (1 << numFadingStages) - 1,
+                  "stage weights are indexed by stage bit");
+    static constexpr int stageCrossfadeSamples = 256;
+
+    struct ChunkSettings
+    {
+        const WavetableOscillator::TableSet* tables = nullptr;
+        float* left = nullptr;              // output for this chunk
+        float* right = nullptr;             // nullptr for mono output
+        int numSamples = 0;
+
+        juce::uint32 lfoInc = 0;
+        juce::uint32 autoPanInc = 0;
+        float chaosAmount = 0.0f;
+        float autoPanAmount = 0.0f;
+        float glitchProbability = 0.0f;
+        float subMix = 0.0f;
+        float envFilterAmount = 0.0f;
+        float crushAmount = 0.0f;
+        float delayMix = 0.0f;
+        float delayFeedback = 0.0f;
+
+        // Per-sample weight of each fading stage; only read while crossfading
+        const float* chaosGain = nullptr;
+        const float* autoPanGain = nullptr;
+        const float* glitchGain = nullptr;
+    };
+
+    using ChunkRenderer = bool (MainComponent::*)(const ChunkSettings&) noexcept;
+
+    std::array<float, numFadingStages> stageWeights {};     // as of the end of the last chunk
+    float heldChaosAmount = 0.0f;                   // last amounts of each stage, for fading it out
+    float heldAutoPanAmount = 0.0f;
+    float heldGlitchProbability = 0.0f;
+    alignas(32) std::array<std::array<float, renderChunkSize>, numFadingStages> stageRamps {};
+    alignas(32) std::array<float, renderChunkSize> stageUnity {};
+
     // ===== UI Controls =====
     juce::TextButton playButton { "Play" };
     juce::TextButton stopButton { "Stop" };
@@ -119,10 +293,12 @@ private:
     juce::Label     bpmLabel;
 
     juce::Slider waveKnob, gainKnob, attackKnob, decayKnob, sustainKnob, widthKnob;
-    juce::Slider pitchKnob, cutoffKnob, resonanceKnob, releaseKnob;
+    juce::Slider pitchKnob, cutoffKnob, resonanceKnob, filterTypeKnob, releaseKnob;
     juce::Slider lfoKnob, lfoDepthKnob, filterModKnob, lfoModeKnob, lfoStartKnob;
     juce::Slider driveKnob, crushKnob, subMixKnob, envFilterKnob;
-    juce::Slider chaosKnob, delayKnob, autoPanKnob, glitchKnob;
+    juce::Slider chaosKnob, delayKnob, delayModeKnob, autoPanKnob, glitchKnob;
+    juce::Slider unisonKnob, unisonSpreadKnob, unisonStereoKnob;
+    juce::Slider oversampleKnob, partialsKnob;
 
     juce::Label waveLabel, waveValue;
     juce::Label gainLabel, gainValue;
@@ -133,6 +309,7 @@ private:
     juce::Label pitchLabel, pitchValue;
     juce::Label cutoffLabel, cutoffValue;
     juce::Label resonanceLabel, resonanceValue;
+    juce::Label filterTypeLabel, filterTypeValue;
     juce::Label releaseLabel, releaseValue;
     juce::Label lfoLabel, lfoValue;
     juce::Label lfoDepthLabel, lfoDepthValue;
@@ -145,42 +322,78 @@ private:
     juce::Label envFilterLabel, envFilterValue;
     juce::Label chaosLabel, chaosValueLabel;
     juce::Label delayLabel, delayValue;
+    juce::Label delayModeLabel, delayModeValue;
     juce::Label autoPanLabel, autoPanValue;
     juce::Label glitchLabel, glitchValue;
+    juce::Label unisonLabel, unisonValue;
+    juce::Label unisonSpreadLabel, unisonSpreadValue;
+    juce::Label unisonStereoLabel, unisonStereoValue;
+    juce::Label oversampleLabel, oversampleValue;
+    juce::Label partialsLabel, partialsValue;
 
     juce::TextButton audioToggle{ "Audio ON" };
-    bool audioEnabled = true;
+    bool audioEnabled = true;                       // audio thread's copy of Param::audioEnabled
+
+    // ===== Block events =====
+    // Everything that starts or stops a voice or changes a parameter reaches
+    // the audio thread as an event at a sample offset into the block, and
+    // the render loop splits its chunks at those offsets so each one lands
+    // on its exact sample.
+    struct BlockEvent
+    {
+        enum Type { noteOn = 0, noteOff, allNotesOff, parameterChange };
+
+        int sampleOffset = 0;
+        Type type = noteOn;
+        int midiNote = 0;
+        float velocity = 0.0f;
+        Param parameter = Param::waveMorph;
+        float value = 0.0f;
+    };
+
+    // A note event queued for the audio thread, stamped with when it arrived
+    // (juce::Time::getMillisecondCounterHiRes()). The audio thread turns the
+    // stamp into an offset in the block, one block after the arrival.
+    struct TimedNoteEvent
+    {
+        double arrivalMs = 0.0;
+        BlockEvent event;
+    };
+
+    static constexpr int maxBlockEvents = 512;
+    static constexpr int noteQueueSize = 1024;
+
+    juce::MidiBuffer blockMidi;                     // piano roll notes, reused every block
+    std::array<BlockEvent, maxBlockEvents> blockEvents {};
+    int numBlockEvents = 0;
+
+    // Hardware MIDI (MIDI thread) and the on-screen keyboard (message thread)
+    // each get their own queue, so both stay single-producer. Notes the audio
+    // thread plays from the roll or hardware go back the other way so the
+    // on-screen keyboard can show them.
+    SpscRingBuffer<TimedNoteEvent> midiInputQueue;
+    SpscRingBuffer<TimedNoteEvent> keyboardQueue;
+    SpscRingBuffer<BlockEvent> keyboardDisplayQueue;
+    std::array<TimedNoteEvent, maxBlockEvents> drainedNotes {};
+    std::array<Parameters::Change, maxBlockEvents> drainedChanges {};
+    std::array<BlockEvent, maxBlockEvents> displayedNotes {};
+    bool updatingKeyboardDisplay = false;           // message thread: echoing played notes to keyboardState
 
     // ===== MIDI keyboard UI =====
     juce::MidiKeyboardState keyboardState;
     juce::MidiKeyboardComponent keyboardComponent { keyboardState, juce::MidiKeyboardComponent::horizontalKeyboard };
 
-    // ===== MIDI state (monophonic, last-note priority) =====
-    juce::Array<int> noteStack;   // holds pressed MIDI notes
-    int currentMidiNote = -1;
-    float currentVelocity = 1.0f;
-    bool midiGate = false;        // gate controlled by MIDI
 
-    // Scope area cache (so paint knows where to draw when keyboard steals space)
-    juce::Rectangle<int> scopeRect;
+    // Scope strip below the visualiser; repaints only itself when a frame arrives
+    ScopeComponent scopeView;
     juce::Rectangle<int> osc3DRect;
-    std::vector<float> waveformSnapshot;
-
-    std::atomic<float> smoothedLevel { 0.0f };
-    std::atomic<float> lowBandLevel { 0.0f };
-    std::atomic<float> midBandLevel { 0.0f };
-    std::atomic<float> highBandLevel { 0.0f };
-    std::atomic<float> delayFeedbackVisual { 0.0f };
-    std::atomic<float> glitchHoldVisual { 0.0f };
-
-    float meterSmoother = 0.0f;
-    float lowBandSmoother = 0.0f;
-    float midBandSmoother = 0.0f;
-    float highBandSmoother = 0.0f;
+
+    // Metering and spectrum, computed on the analyser's own thread from the
+    // output the audio callback pushes to it
+    AudioAnalyser analyser;
+    AudioAnalyser::Frame analysisFrame;
+    alignas(32) std::array<float, renderChunkSize> analysisMono {};
     float delayVisualSmoother = 0.0f;
-    float glitchVisualSmoother = 0.0f;
-    float lowBandState = 0.0f;
-    float midBandState = 0.0f;
 
     // ===== Helpers =====
     void initialiseUi();
@@ -194,26 +407,35 @@ private:
     void configureValueLabel(juce::Label& label);
     void updateAmplitudeEnvelope();
     void triggerLfo();
+    static bool toNoteEvent(const juce::MidiMessage& message, BlockEvent& event) noexcept;
+    int getArrivalOffset(double arrivalMs, int numSamples, double blockStartMs) const noexcept;
+    void drainParameterChanges(int numSamples, double blockStartMs) noexcept;
+    void applyParameter(Param id, float value) noexcept;
+    void applyAllParameters() noexcept;
+    void resyncParameters() noexcept;
+    void collectBlockEvents(const juce::MidiBuffer& midi, int numSamples) noexcept;
+    void drainNoteQueue(SpscRingBuffer<TimedNoteEvent>& queue, int numSamples, double blockStartMs, bool display) noexcept;
+    void sortBlockEvents() noexcept;
+    void applyBlockEvent(const BlockEvent& event) noexcept;
+    void updateKeyboardDisplay();
+    void updateOversampleLabel();
 
     void resetSmoothers(double sampleRate);
-    void setTargetFrequency(float newFrequency, bool force = false);
-    void updateFilterCoeffs(double cutoff, double Q);
-    void updateFilterStatic();
-    inline float renderMorphSample(float ph, float morph, float normPhaseInc) const;
-    inline float polyBlep(float t, float dt) const;
-    int findZeroCrossingIndex(int searchSpan) const;
+    float getDelayTimeSamples(float amount) const noexcept;
+    void applyOversampling();
+    void applyCrush(float* left, float* right, int numSamples, float crushAmt) noexcept;
+    void applyDelay(float* left, float* right, int numSamples, float mix, float feedback) noexcept;
+    bool renderChunk(int stages, ChunkSettings& settings) noexcept;
+
+    template <int Stages, bool Crossfade>
+    bool renderChunkStages(const ChunkSettings& settings) noexcept;
+
+    template <size_t... Index>
+    static constexpr std::array<ChunkRenderer, sizeof...(Index)> makeChunkRenderers(std::index_sequence<Index...>) noexcept;
+    void updateWavetableShape();
     void captureWaveformSnapshot();
     void timerCallback() override;
 
-    inline float sine(float ph) const { return std::sin(ph); }
-    inline float tri(float ph)  const { return (2.0f / juce::MathConstants<float>::pi) * std::asin(std::sin(ph)); }
-
-    static inline float midiNoteToFreq(int midiNote)
-    {
-        // A4 = 440 Hz, MIDI 69
-        return 440.0f * std::pow(2.0f, (midiNote - 69) / 12.0f);
-    }
-
     std::unique_ptr<MidiRollComponent> midiRoll;
     std::unique_ptr<OscVisualizerComponent> oscVisualizer;
 
@@ -35,6 +35,15 @@ namespace
         if (n.startBeat + n.lengthBeats > maxBeats)
             n.lengthBeats = std::max(beatGrid, maxBeats - n.startBeat);
     }
+
+    // Makes the epoch odd for as long as a block may be reading a snapshot
+    struct EpochScope
+    {
+        explicit EpochScope(std::atomic<juce::uint64>& e) : epoch(e) { epoch.fetch_add(1); }
+        ~EpochScope() { epoch.fetch_add(1); }
+
+        std::atomic<juce::uint64>& epoch;
+    };
 }
 
 //==============================================================================
@@ -44,6 +53,7 @@ MidiRollComponent::MidiRollComponent()
     setOpaque(true);
     startTimerHz(60); // refresh at ~60fps for playhead
 
+    publishNotes();
     updateLoopLengthFromNotes();
 }
 
@@ -51,11 +61,9 @@ MidiRollComponent::MidiRollComponent()
 
 void MidiRollComponent::clearNotes()
 {
-    {
-        const juce::SpinLock::ScopedLockType lock(noteMutex);
-        notes.clear();
-    }
+    notes.clear();
 
+    publishNotes();
     updateLoopLengthFromNotes();
     flushActiveNotes.store(true);
     repaint();
@@ -150,25 +158,27 @@ void MidiRollComponent::setLoopLengthBeats(double beats)
     repaint();
 }
 
-void MidiRollComponent::updateLoopLengthFromNotes()
+double MidiRollComponent::computeLoopLength(const std::vector<Note>& noteList) noexcept
 {
     double maxBeat = 0.0;
+    for (const auto& note : noteList)
     {
-        const juce::SpinLock::ScopedLockType lock(noteMutex);
-        for (const auto& note : notes)
-        {
-            const double length = std::max(0.0, note.lengthBeats);
-            maxBeat = std::max(maxBeat, note.startBeat + length);
-        }
+        const double length = std::max(0.0, note.lengthBeats);
+        maxBeat = std::max(maxBeat, note.startBeat + length);
     }
 
     const double bars = std::ceil(maxBeat / 4.0);
-    const double newLength = std::max(kMinLoopBeats,
-                                      bars > 0.0 ? bars * 4.0 : kMinLoopBeats);
-    setLoopLengthBeats(newLength);
+    const double length = std::max(kMinLoopBeats,
+                                   bars > 0.0 ? bars * 4.0 : kMinLoopBeats);
+    return juce::jlimit(kMinLoopBeats, kMaxLoopBeats, length);
+}
+
+void MidiRollComponent::updateLoopLengthFromNotes()
+{
+    setLoopLengthBeats(computeLoopLength(notes));
 }
 
-int MidiRollComponent::hitTestNoteUnlocked(int x, int y) const
+int MidiRollComponent::hitTestNote(int x, int y) const
 {
     for (int i = static_cast<int>(notes.size()) - 1; i >= 0; --i)
     {
@@ -184,10 +194,75 @@ int MidiRollComponent::hitTestNoteUnlocked(int x, int y) const
     return -1;
 }
 
-int MidiRollComponent::hitTestNote(int x, int y) const
+//==============================================================================
+// Snapshot publishing
+//
+// The audio thread never touches `notes`. After each edit the message thread
+// copies the pattern into a new immutable snapshot and swaps it in with one
+// atomic store; the audio thread picks it up with one atomic load. The old
+// snapshot is parked with the audio epoch at the time of the swap and
+// released from the timer once the audio thread has moved past that epoch.
+
+MidiRollComponent::NoteSnapshot::NoteSnapshot(const std::vector<Note>& noteList,
+                                              double loopLength,
+                                              juce::uint64 snapshotGeneration)
+    : loopLengthBeats(loopLength),
+      generation(snapshotGeneration)
+{
+    auto wrap = [loopLength](double beat)
+    {
+        double b = std::fmod(beat, loopLength);
+        if (b < 0.0)
+            b += loopLength;
+        return b;
+    };
+
+    events.reserve(noteList.size() * 2);
+
+    for (const auto& note : noteList)
+    {
+        const double noteLength = std::max(0.0, note.lengthBeats);
+        const int midiNote = juce::jlimit(0, 127, note.midiNote);
+        events.push_back({ wrap(note.startBeat), midiNote, true });
+        events.push_back({ wrap(note.startBeat + noteLength), midiNote, false });
+    }
+
+    // Note-offs first on a shared beat, so a note ending where the next one
+    // starts doesn't cut off its successor
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b)
+    {
+        if (a.beat != b.beat)
+            return a.beat < b.beat;
+        return !a.isNoteOn && b.isNoteOn;
+    });
+}
+
+void MidiRollComponent::publishNotes()
 {
-    const juce::SpinLock::ScopedLockType lock(noteMutex);
-    return hitTestNoteUnlocked(x, y);
+    NoteSnapshot::Ptr snapshot = new NoteSnapshot(notes, computeLoopLength(notes), ++snapshotGeneration);
+    liveSnapshot.store(snapshot.get());
+
+    if (publishedSnapshot != nullptr)
+        retiredSnapshots.push_back({ publishedSnapshot, audioEpoch.load() });
+
+    publishedSnapshot = snapshot;
+}
+
+void MidiRollComponent::reclaimRetiredSnapshots()
+{
+    if (retiredSnapshots.empty())
+        return;
+
+    const auto epoch = audioEpoch.load();
+
+    // Safe once no block was running at the swap (even epoch), or the one
+    // that was has since finished
+    retiredSnapshots.erase(std::remove_if(retiredSnapshots.begin(), retiredSnapshots.end(),
+                                          [epoch](const RetiredSnapshot& r)
+                                          {
+                                              return (r.audioEpoch & 1) == 0 || epoch != r.audioEpoch;
+                                          }),
+                           retiredSnapshots.end());
 }
 
 //==============================================================================
@@ -202,12 +277,6 @@ void MidiRollComponent::paint(juce::Graphics& g)
     const double pixelsPerBeat = getPixelsPerBeat();
     const double totalBeats    = getLoopLengthBeats();
 
-    std::vector<Note> noteSnapshot;
-    {
-        const juce::SpinLock::ScopedLockType lock(noteMutex);
-        noteSnapshot = notes;
-    }
-
     // Piano-key strip
     juce::Rectangle<int> keyStrip(0, 0, kLeftMargin, height);
     g.setColour(juce::Colour::fromRGB(10, 25, 28));
@@ -263,9 +332,9 @@ void MidiRollComponent::paint(juce::Graphics& g)
     }
 
     // Notes
-    for (size_t i = 0; i < noteSnapshot.size(); ++i)
+    for (size_t i = 0; i < notes.size(); ++i)
     {
-        const auto& n = noteSnapshot[i];
+        const auto& n = notes[i];
         const int noteY = pitchToY(n.midiNote) + 1;
         const int noteH = kNoteHeight - 3;
         const int noteX = beatToX(n.startBeat);
@@ -337,12 +406,15 @@ void MidiRollComponent::renderNextMidiBlock(juce::MidiBuffer& buffer,
     if (numSamples <= 0 || sampleRate <= 0.0)
         return;
 
+    const EpochScope epochScope(audioEpoch);
+
     if (flushActiveNotes.exchange(false))
     {
-        for (int midiNote : activeNotes)
-            buffer.addEvent(juce::MidiMessage::noteOff(1, midiNote), 0);
+        for (int midiNote = 0; midiNote < static_cast<int>(activeNotes.size()); ++midiNote)
+            if (activeNotes.test(static_cast<size_t>(midiNote)))
+                buffer.addEvent(juce::MidiMessage::noteOff(1, midiNote), 0);
 
-        activeNotes.clear();
+        activeNotes.reset();
     }
 
     if (!isCurrentlyPlaying())
@@ -355,68 +427,75 @@ void MidiRollComponent::renderNextMidiBlock(juce::MidiBuffer& buffer,
     if (blockBeats <= 0.0)
         return;
 
-    double startBeat = playheadBeat.load();
-
-    std::vector<Note> noteSnapshot;
-    {
-        const juce::SpinLock::ScopedLockType lock(noteMutex);
-        noteSnapshot = notes;
-    }
+    const NoteSnapshot* snapshot = liveSnapshot.load();
+    if (snapshot == nullptr)
+        return;
 
-    const double totalBeats = getLoopLengthBeats();
+    const auto& events = snapshot->events;
+    const double totalBeats = snapshot->loopLengthBeats;
     if (totalBeats <= 0.0)
         return;
 
-    auto normaliseBeat = [totalBeats](double beat)
+    double startBeat = std::fmod(playheadBeat.load(), totalBeats);
+    if (startBeat < 0.0)
+        startBeat += totalBeats;
+
+    // The cursor carries over from the previous block unless the pattern was
+    // replaced or the playhead moved under us (start, stop, loop resize)
+    if (snapshot->generation != cursorGeneration || startBeat != cursorBeat)
     {
-        double b = std::fmod(beat, totalBeats);
-        if (b < 0.0)
-            b += totalBeats;
-        return b;
-    };
+        const auto first = std::lower_bound(events.begin(), events.end(), startBeat,
+                                            [](const NoteSnapshot::Event& ev, double beat)
+                                            {
+                                                return ev.beat < beat;
+                                            });
+        eventCursor = static_cast<size_t>(first - events.begin());
+        cursorGeneration = snapshot->generation;
+    }
 
-    startBeat = normaliseBeat(startBeat);
+    // Walk [startBeat, startBeat + blockBeats), wrapping at the loop end
+    double segmentStart = startBeat;
+    double beatsDone = 0.0;
 
-    auto addEventIfInBlock = [&](double rawBeat, bool isNoteOn, int midiNote)
+    while (beatsDone < blockBeats)
     {
-        double beat = normaliseBeat(rawBeat);
+        const double segmentBeats = std::min(blockBeats - beatsDone, totalBeats - segmentStart);
+        const double segmentEnd = segmentStart + segmentBeats;
 
-        double deltaBeats = beat - startBeat;
-        while (deltaBeats < 0.0)
-            deltaBeats += totalBeats;
+        for (; eventCursor < events.size() && events[eventCursor].beat < segmentEnd; ++eventCursor)
+        {
+            const auto& ev = events[eventCursor];
+            const double deltaBeats = beatsDone + (ev.beat - segmentStart);
 
-        if (deltaBeats < 0.0 || deltaBeats >= blockBeats)
-            return;
+            int sample = static_cast<int>(std::round(deltaBeats / beatsPerSample));
+            sample = juce::jlimit(0, std::max(0, numSamples - 1), sample);
 
-        int sample = static_cast<int>(std::round(deltaBeats / beatsPerSample));
-        sample = juce::jlimit(0, std::max(0, numSamples - 1), sample);
+            const auto bit = static_cast<size_t>(ev.midiNote);
 
-        if (isNoteOn)
-        {
-            buffer.addEvent(juce::MidiMessage::noteOn(1, midiNote, static_cast<juce::uint8>(100)), sample);
-            if (std::find(activeNotes.begin(), activeNotes.end(), midiNote) == activeNotes.end())
-                activeNotes.push_back(midiNote);
+            if (ev.isNoteOn)
+            {
+                buffer.addEvent(juce::MidiMessage::noteOn(1, ev.midiNote, static_cast<juce::uint8>(100)), sample);
+                activeNotes.set(bit);
+            }
+            else
+            {
+                buffer.addEvent(juce::MidiMessage::noteOff(1, ev.midiNote), sample);
+                activeNotes.reset(bit);
+            }
         }
-        else
+
+        beatsDone += segmentBeats;
+        segmentStart = segmentEnd;
+
+        if (segmentStart >= totalBeats)
         {
-            buffer.addEvent(juce::MidiMessage::noteOff(1, midiNote), sample);
-            activeNotes.erase(std::remove(activeNotes.begin(), activeNotes.end(), midiNote), activeNotes.end());
+            segmentStart = 0.0;
+            eventCursor = 0;
         }
-    };
-
-    for (const auto& note : noteSnapshot)
-    {
-        const double noteLength = std::max(0.0, note.lengthBeats);
-        addEventIfInBlock(note.startBeat, true, note.midiNote);
-        addEventIfInBlock(note.startBeat + noteLength, false, note.midiNote);
     }
 
-    double newBeat = startBeat + blockBeats;
-    newBeat = std::fmod(newBeat, totalBeats);
-    if (newBeat < 0.0)
-        newBeat += totalBeats;
-
-    playheadBeat.store(newBeat);
+    playheadBeat.store(segmentStart);
+    cursorBeat = segmentStart;
 }
 
 //==============================================================================
@@ -424,6 +503,8 @@ void MidiRollComponent::renderNextMidiBlock(juce::MidiBuffer& buffer,
 
 void MidiRollComponent::timerCallback()
 {
+    reclaimRetiredSnapshots();
+
     if (isCurrentlyPlaying())
         repaint();
 }
@@ -444,9 +525,7 @@ void MidiRollComponent::mouseDown(const juce::MouseEvent& e)
 
     if (draggingNoteIndex >= 0)
     {
-        const juce::SpinLock::ScopedLockType lock(noteMutex);
-
-        if (draggingNoteIndex >= 0 && draggingNoteIndex < static_cast<int>(notes.size()))
+        if (draggingNoteIndex < static_cast<int>(notes.size()))
         {
             auto& n = notes[static_cast<size_t>(draggingNoteIndex)];
             if (e.mods.isRightButtonDown())
@@ -477,56 +556,51 @@ void MidiRollComponent::mouseDown(const juce::MouseEvent& e)
 
         quantizeNote(n, getLoopLengthBeats());
 
-        {
-            const juce::SpinLock::ScopedLockType lock(noteMutex);
-            notes.push_back(n);
-            draggingNoteIndex = static_cast<int>(notes.size()) - 1;
-        }
+        notes.push_back(n);
+        draggingNoteIndex = static_cast<int>(notes.size()) - 1;
         resizingNote = true;
         shouldUpdateLoop = true;
     }
 
     if (shouldUpdateLoop)
+    {
+        publishNotes();
         updateLoopLengthFromNotes();
+    }
 
     repaint();
 }
 
 void MidiRollComponent::mouseDrag(const juce::MouseEvent& e)
 {
-    bool changed = false;
-
-    {
-        const juce::SpinLock::ScopedLockType lock(noteMutex);
-
-        if (draggingNoteIndex < 0 || draggingNoteIndex >= static_cast<int>(notes.size()))
-            return;
-
-        auto& n = notes[static_cast<size_t>(draggingNoteIndex)];
-        const auto p = e.getPosition();
-
-        if (resizingNote)
-        {
-            const double endBeat = juce::jlimit(n.startBeat + 0.1, kMaxLoopBeats, xToBeat(p.x));
-            n.lengthBeats = endBeat - n.startBeat;
-        }
-        else
-        {
-            const double newStart = juce::jlimit(0.0, kMaxLoopBeats - n.lengthBeats, xToBeat(p.x) - dragOffsetBeat);
-            n.startBeat = newStart;
-            n.midiNote  = yToPitch(p.y);
-        }
+    if (draggingNoteIndex < 0 || draggingNoteIndex >= static_cast<int>(notes.size()))
+        return;
 
-        quantizeNote(n, getLoopLengthBeats());
+    auto& n = notes[static_cast<size_t>(draggingNoteIndex)];
+    const auto p = e.getPosition();
+    const Note before = n;
 
-        changed = true;
+    if (resizingNote)
+    {
+        const double endBeat = juce::jlimit(n.startBeat + 0.1, kMaxLoopBeats, xToBeat(p.x));
+        n.lengthBeats = endBeat - n.startBeat;
     }
-
-    if (changed)
+    else
     {
-        updateLoopLengthFromNotes();
-        repaint();
+        const double newStart = juce::jlimit(0.0, kMaxLoopBeats - n.lengthBeats, xToBeat(p.x) - dragOffsetBeat);
+        n.startBeat = newStart;
+        n.midiNote  = yToPitch(p.y);
     }
+
+    quantizeNote(n, getLoopLengthBeats());
+
+    // Quantisation swallows most mouse moves; only publish real changes
+    if (n.midiNote == before.midiNote && n.startBeat == before.startBeat && n.lengthBeats == before.lengthBeats)
+        return;
+
+    publishNotes();
+    updateLoopLengthFromNotes();
+    repaint();
 }
 
 void MidiRollComponent::mouseUp(const juce::MouseEvent&)
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include <atomic>
+#include <bitset>
 #include <vector>
 
 class MidiRollComponent : public juce::Component,
@@ -45,8 +46,45 @@ private:
     static constexpr int    kTopMargin        = 4;
     static constexpr int    kLeftMargin       = 24;
 
+    // Immutable copy of the pattern handed to the audio thread, compiled
+    // into note-on/off events sorted by loop position. Every edit publishes a
+    // fresh one; the audio thread only ever reads the live one.
+    struct NoteSnapshot : public juce::ReferenceCountedObject
+    {
+        struct Event
+        {
+            double beat     = 0.0;      // wrapped into [0, loopLengthBeats)
+            int    midiNote = 60;
+            bool   isNoteOn = true;
+        };
+
+        NoteSnapshot (const std::vector<Note>& notes, double loopLength, juce::uint64 generation);
+
+        using Ptr = juce::ReferenceCountedObjectPtr<NoteSnapshot>;
+        std::vector<Event> events;
+        double loopLengthBeats = kMinLoopBeats;
+        juce::uint64 generation = 0;
+    };
+
+    // A replaced snapshot, kept alive until the audio thread has left every
+    // block that might still be reading it
+    struct RetiredSnapshot
+    {
+        NoteSnapshot::Ptr snapshot;
+        juce::uint64 audioEpoch = 0;
+    };
+
+    // Editable pattern, message thread only
     std::vector<Note> notes;
-    mutable juce::SpinLock noteMutex;
+
+    NoteSnapshot::Ptr publishedSnapshot;                // owns the live snapshot
+    juce::uint64 snapshotGeneration = 0;
+    std::atomic<NoteSnapshot*> liveSnapshot { nullptr };
+    std::vector<RetiredSnapshot> retiredSnapshots;
+
+    // Bumped by the audio thread on entering and leaving renderNextMidiBlock,
+    // so it's odd while a block is in progress
+    std::atomic<juce::uint64> audioEpoch { 0 };
 
     // View state
     double scrollY = 0.0;
@@ -60,7 +98,13 @@ private:
     double secondsPerBeat = 0.5;
 
     std::atomic<bool> flushActiveNotes { false };
-    std::vector<int> activeNotes;
+
+    // Audio thread: next event to fire, and where the playhead was expected
+    // to be when it was found. Either going stale triggers a re-seek.
+    size_t eventCursor = 0;
+    juce::uint64 cursorGeneration = 0;
+    double cursorBeat = -1.0;
+    std::bitset<128> activeNotes;
 
     // Drag/edit state
     int     draggingNoteIndex = -1;
@@ -79,8 +123,10 @@ private:
     void   clampVerticalScroll();
     void   setLoopLengthBeats (double beats);
     void   updateLoopLengthFromNotes();
+    static double computeLoopLength (const std::vector<Note>& notes) noexcept;
     int    hitTestNote (int x, int y) const;
-    int    hitTestNoteUnlocked (int x, int y) const;
+    void   publishNotes();
+    void   reclaimRetiredSnapshots();
 
     void timerCallback() override;
 
@@ -1,95 +1,149 @@
 #include "OscVisualizerComponent.h"
 
-OscVisualizerComponent::OscVisualizerComponent() = default;
-OscVisualizerComponent::~OscVisualizerComponent() = default;
+namespace
+{
+    // Steps per unit the sphere's knob-driven colours are quantised to before
+    // they're allowed to trigger a redraw of the sphere layer
+    constexpr float sphereKeySteps = 32.0f;
 
-void OscVisualizerComponent::setVisualData(float smoothedLevel, float lowBand, float midBand, float highBand,
-    float delayFeedback, float glitchEnergy, float driveAmount,
-    float delayAmount, float chaosAmount,
-    const std::vector<float>& waveformSnapshot)
-{
-    this->smoothedLevel = smoothedLevel;
-    this->lowBand = lowBand;
-    this->midBand = midBand;
-    this->highBand = highBand;
-    this->delayFeedbackEnergy = delayFeedback;
-    this->glitchEnergy = glitchEnergy;
-    this->driveAmount = driveAmount;
-    this->delayAmount = delayAmount;
-    this->chaosAmount = chaosAmount;
-    this->waveformSnapshot = waveformSnapshot;
-    repaint();
+    constexpr int renderIdleWaitMs = 100;
+
+    constexpr int detailBoxWidth = 96;
+    constexpr int detailBoxHeight = 22;
+    constexpr int detailBoxMargin = 10;
+
+    juce::Image makeLayerImage(juce::Rectangle<float> bounds, float scale)
+    {
+        return juce::Image(juce::Image::ARGB,
+                           juce::jmax(1, juce::roundToInt(bounds.getWidth() * scale)),
+                           juce::jmax(1, juce::roundToInt(bounds.getHeight() * scale)),
+                           true, juce::SoftwareImageType());
+    }
 }
 
-void OscVisualizerComponent::paint(juce::Graphics& g)
+//==============================================================================
+// Draws the fast layer (level glow and rim, spectrum rays and waveform) off
+// the message thread.
+// Parks until the component posts a frame, draws it into the write side of
+// dynamicLayers and publishes it; paint() blits whichever image is newest.
+class OscVisualizerComponent::Renderer : public juce::Thread
 {
-    g.fillAll(juce::Colours::black);
+public:
+    explicit Renderer(OscVisualizerComponent& ownerComponent)
+        : juce::Thread("Visualiser render"),
+          owner(ownerComponent)
+    {
+        // A start, a line per point and a close, each a type tag plus coordinates
+        waveformPath.preallocateSpace(3 * maxSnapshotResolution + 8);
+    }
 
-    auto visualBounds = getLocalBounds().toFloat();
-    juce::ColourGradient background(
-        juce::Colour::fromRGB(8, 10, 22), visualBounds.getBottomLeft(),
-        juce::Colour::fromRGB(18, 32, 60), visualBounds.getTopRight(), false);
-    g.setGradientFill(background);
-    g.fillRoundedRectangle(visualBounds, 20.0f);
+    ~Renderer() override
+    {
+        stopThread(1000);
+    }
 
-    g.setColour(juce::Colours::white.withAlpha(0.08f));
-    g.drawRoundedRectangle(visualBounds, 20.0f, 1.2f);
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            if (owner.dynamicRequests.acquire())
+            {
+                draw(owner.dynamicRequests.getReadBuffer(), owner.dynamicLayers.getWriteBuffer());
+                owner.dynamicLayers.publish();
+            }
 
-    auto sphereBounds = visualBounds.reduced(28.0f, 24.0f);
-    const float diameter = juce::jmin(sphereBounds.getWidth(), sphereBounds.getHeight());
-    if (diameter <= 8.0f)
+            wait(renderIdleWaitMs);
+        }
+    }
+
+private:
+    OscVisualizerComponent& owner;
+    juce::Path waveformPath;
+
+    void draw(const DynamicFrame& frame, juce::Image& image);
+};
+
+void OscVisualizerComponent::Renderer::draw(const DynamicFrame& frame, juce::Image& image)
+{
+    const auto& geometry = frame.geometry;
+    const auto& s = frame.state;
+
+    const int width = juce::jmax(1, juce::roundToInt(geometry.bounds.getWidth() * frame.scale));
+    const int height = juce::jmax(1, juce::roundToInt(geometry.bounds.getHeight() * frame.scale));
+
+    if (!image.isValid() || image.getWidth() != width || image.getHeight() != height)
+        image = makeLayerImage(geometry.bounds, frame.scale);
+    else
+        image.clear(image.getBounds());
+
+    if (!geometry.visible)
         return;
 
-    juce::Rectangle<float> sphereArea(
-        sphereBounds.getCentreX() - diameter * 0.5f,
-        sphereBounds.getCentreY() - diameter * 0.5f,
-        diameter, diameter);
+    juce::Graphics g(image);
+    g.addTransform(juce::AffineTransform::scale(frame.scale));
 
-    const float hueBase = std::fmod(juce::jmap(driveAmount, 0.0f, 1.0f, 0.62f, 0.02f) + 1.0f, 1.0f);
-    const float brightness = juce::jlimit(0.2f, 1.0f,
-        juce::jmap(delayAmount, 0.0f, 1.0f, 0.35f, 0.92f) + smoothedLevel * 0.12f);
-    const float saturation = juce::jlimit(0.25f, 1.0f,
-        juce::jmap(chaosAmount, 0.0f, 1.0f, 0.55f, 0.95f) + highBand * 0.05f);
+    const auto& sphereArea = geometry.sphereArea;
+    const auto centre = sphereArea.getCentre();
+    const float outerRadius = geometry.outerRadius;
 
-    juce::ColourGradient sphereGradient(
-        juce::Colour::fromHSV(hueBase, saturation,
-            juce::jlimit(0.2f, 1.0f, brightness + smoothedLevel * 0.18f), 1.0f),
-        sphereArea.getCentre(),
-        juce::Colour::fromHSV(std::fmod(hueBase + 0.11f, 1.0f),
-            juce::jlimit(0.25f, 1.0f, saturation * 0.65f + midBand * 0.25f),
-            juce::jlimit(0.15f, 1.0f, 0.25f + brightness * 0.65f), 1.0f),
+    // Level-driven glow and rim over the cached sphere; they move every frame,
+    // so they live here rather than in the sphere layer's key
+    juce::ColourGradient glow(
+        juce::Colour::fromHSV(geometry.hueBase, geometry.saturation * 0.5f, 1.0f,
+            juce::jlimit(0.0f, 0.35f, s.smoothedLevel * 0.22f)),
+        centre,
+        juce::Colour::fromHSV(std::fmod(geometry.hueBase + 0.11f, 1.0f),
+            juce::jlimit(0.25f, 1.0f, geometry.saturation * 0.65f + s.midBand * 0.25f), 1.0f, 0.0f),
         sphereArea.getBottomRight(), true);
-
-    g.setGradientFill(sphereGradient);
+    g.setGradientFill(glow);
     g.fillEllipse(sphereArea);
 
-    g.setColour(juce::Colour::fromHSV(std::fmod(hueBase + 0.02f, 1.0f),
-        juce::jlimit(0.25f, 1.0f, saturation * 0.55f + midBand * 0.2f),
-        juce::jlimit(0.15f, 1.0f, 0.4f + brightness * 0.35f + smoothedLevel * 0.2f),
-        juce::jlimit(0.1f, 0.6f, 0.22f + smoothedLevel * 0.25f)));
-    g.drawEllipse(sphereArea, juce::jlimit(0.8f, 1.8f, 1.0f + highBand * 0.6f));
+    g.setColour(juce::Colour::fromHSV(std::fmod(geometry.hueBase + 0.02f, 1.0f),
+        juce::jlimit(0.25f, 1.0f, geometry.saturation * 0.55f + s.midBand * 0.2f),
+        juce::jlimit(0.15f, 1.0f, 0.4f + geometry.brightness * 0.35f + s.smoothedLevel * 0.2f),
+        juce::jlimit(0.1f, 0.6f, 0.22f + s.smoothedLevel * 0.25f)));
+    g.drawEllipse(sphereArea, juce::jlimit(0.8f, 1.8f, 1.0f + s.highBand * 0.6f));
 
-    const auto centre = sphereArea.getCentre();
-    const float outerRadius = sphereArea.getWidth() * 0.5f;
-    const float activeRadius = outerRadius * juce::jlimit(0.75f, 1.22f, 0.88f + smoothedLevel * 0.35f);
+    const float activeRadius = outerRadius * juce::jlimit(0.75f, 1.22f, 0.88f + s.smoothedLevel * 0.35f);
     const float innerRadius = juce::jlimit(outerRadius * 0.18f, activeRadius * 0.92f,
-        outerRadius * juce::jmap(juce::jlimit(0.0f, 1.0f, lowBand), 0.0f, 1.0f, 0.3f, 0.48f));
+        outerRadius * juce::jmap(juce::jlimit(0.0f, 1.0f, s.lowBand), 0.0f, 1.0f, 0.3f, 0.48f));
+
+    // Spectrum as a ring of rays around the sphere, lowest band at the top
+    const float rayRoom = juce::jmin(geometry.bounds.getWidth(), geometry.bounds.getHeight()) * 0.5f - outerRadius - 6.0f;
+    if (frame.numSpectrumBands > 0 && rayRoom > 2.0f)
+    {
+        g.setColour(juce::Colour::fromHSV(std::fmod(geometry.hueBase + 0.5f, 1.0f), geometry.saturation * 0.6f, 0.95f,
+            juce::jlimit(0.15f, 0.7f, 0.2f + s.rmsLevel * 1.2f)));
 
-    if (waveformSnapshot.empty())
+        const float rayWidth = juce::jlimit(1.0f, 3.0f, outerRadius * 4.0f / (float)frame.numSpectrumBands);
+
+        for (int b = 0; b < frame.numSpectrumBands; ++b)
+        {
+            const float angle = juce::MathConstants<float>::twoPi * (float)b / (float)frame.numSpectrumBands
+                - juce::MathConstants<float>::halfPi;
+            const float start = outerRadius + 3.0f;
+            const float end = start + rayRoom * juce::jlimit(0.0f, 1.0f, frame.spectrum[(size_t)b]);
+            g.drawLine(centre.x + std::cos(angle) * start, centre.y + std::sin(angle) * start,
+                       centre.x + std::cos(angle) * end, centre.y + std::sin(angle) * end, rayWidth);
+        }
+    }
+
+    const auto& snapshot = frame.snapshot;
+    if (snapshot.size <= 0)
         return;
 
-    juce::Path waveformPath;
-    const size_t count = waveformSnapshot.size();
-    const double timeNow = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    waveformPath.clear();
+    const int count = snapshot.size;
+    const double timeNow = frame.timeSeconds;
 
-    for (size_t i = 0; i < count; ++i)
+    for (int i = 0; i < count; ++i)
     {
         const float angle = juce::MathConstants<float>::twoPi * (float)i / (float)count;
-        const float sample = juce::jlimit(-1.0f, 1.0f, waveformSnapshot[i]);
+        const float sample = juce::jlimit(-1.0f, 1.0f, snapshot.points[(size_t)i]);
         const float breathing = std::sin(angle * 2.0f + (float)timeNow * 0.9f)
-            * midBand * outerRadius * 0.05f;
+            * s.midBand * outerRadius * 0.05f;
         const float jitter = std::sin(angle * 5.0f + (float)timeNow * 3.0f)
-            * highBand * outerRadius * (0.03f + glitchEnergy * 0.04f);
+            * s.highBand * outerRadius * (0.03f + s.glitchEnergy * 0.04f);
         const float warpedRadius = juce::jmap(sample, -1.0f, 1.0f, innerRadius, activeRadius)
             + breathing + jitter;
         const float radius = juce::jlimit(innerRadius * 0.7f, outerRadius * 1.2f, warpedRadius);
@@ -103,20 +157,220 @@ void OscVisualizerComponent::paint(juce::Graphics& g)
 
     waveformPath.closeSubPath();
 
-    const float trailHue = std::fmod(hueBase + 0.18f + highBand * 0.05f, 1.0f);
+    const float trailHue = std::fmod(geometry.hueBase + 0.18f + s.highBand * 0.05f, 1.0f);
     const float trailSat = juce::jlimit(0.25f, 1.0f,
-        saturation * 0.7f + midBand * 0.4f + glitchEnergy * 0.2f);
+        geometry.saturation * 0.7f + s.midBand * 0.4f + s.glitchEnergy * 0.2f);
     const float trailVal = juce::jlimit(0.25f, 1.0f,
-        0.3f + brightness * 0.7f + smoothedLevel * 0.25f);
+        0.3f + geometry.brightness * 0.7f + s.smoothedLevel * 0.25f);
 
     g.setColour(juce::Colour::fromHSV(trailHue, trailSat, trailVal,
-        juce::jlimit(0.15f, 0.85f, 0.25f + smoothedLevel * 0.5f + lowBand * 0.15f)));
+        juce::jlimit(0.15f, 0.85f, 0.25f + s.smoothedLevel * 0.5f + s.lowBand * 0.15f)));
     g.fillPath(waveformPath);
 
     g.setColour(juce::Colour::fromHSV(std::fmod(trailHue + 0.02f, 1.0f),
-        juce::jlimit(0.2f, 1.0f, trailSat * 0.85f + highBand * 0.25f),
-        juce::jlimit(0.3f, 1.0f, trailVal * 0.85f + highBand * 0.2f), 1.0f));
+        juce::jlimit(0.2f, 1.0f, trailSat * 0.85f + s.highBand * 0.25f),
+        juce::jlimit(0.3f, 1.0f, trailVal * 0.85f + s.highBand * 0.2f), 1.0f));
     g.strokePath(waveformPath,
         juce::PathStrokeType(juce::jlimit(1.1f, 3.6f,
-            1.3f + highBand * 2.0f + glitchEnergy * 0.7f)));
+            1.3f + s.highBand * 2.0f + s.glitchEnergy * 0.7f)));
+}
+
+//==============================================================================
+OscVisualizerComponent::OscVisualizerComponent()
+    : renderer(std::make_unique<Renderer>(*this))
+{
+    detailBox.addItem("Low detail", 64);
+    detailBox.addItem("Medium detail", defaultSnapshotResolution);
+    detailBox.addItem("High detail", 384);
+    detailBox.addItem("Max detail", maxSnapshotResolution);
+    detailBox.setTooltip("Points in the waveform drawn around the sphere");
+    detailBox.onChange = [this] { setSnapshotResolution(detailBox.getSelectedId()); };
+    detailBox.setSelectedId(snapshotResolution, juce::dontSendNotification);
+    addAndMakeVisible(detailBox);
+
+    renderer->startThread(juce::Thread::Priority::low);
+}
+
+OscVisualizerComponent::~OscVisualizerComponent()
+{
+    renderer.reset();
+}
+
+void OscVisualizerComponent::setVisualData(float smoothedLevel, float lowBand, float midBand, float highBand,
+    float delayFeedback, float glitchEnergy, float driveAmount,
+    float delayAmount, float chaosAmount)
+{
+    state.smoothedLevel = smoothedLevel;
+    state.lowBand = lowBand;
+    state.midBand = midBand;
+    state.highBand = highBand;
+    state.delayFeedbackEnergy = delayFeedback;
+    state.glitchEnergy = glitchEnergy;
+    state.driveAmount = driveAmount;
+    state.delayAmount = delayAmount;
+    state.chaosAmount = chaosAmount;
+
+    postDynamicFrame();
+    repaint();
+}
+
+void OscVisualizerComponent::setSpectrum(const float* bands, int numBands, float rmsLevel)
+{
+    numSpectrumBands = juce::jlimit(0, maxSpectrumBands, numBands);
+    std::copy(bands, bands + numSpectrumBands, spectrum.begin());
+    state.rmsLevel = rmsLevel;
+}
+
+void OscVisualizerComponent::setSnapshotResolution(int numPoints) noexcept
+{
+    snapshotResolution = juce::jlimit(16, maxSnapshotResolution, numPoints);
+    detailBox.setSelectedId(snapshotResolution, juce::dontSendNotification);
+}
+
+//==============================================================================
+OscVisualizerComponent::Geometry OscVisualizerComponent::computeGeometry(juce::Rectangle<float> bounds,
+                                                                         const VisualState& s) noexcept
+{
+    Geometry geometry;
+    geometry.bounds = bounds;
+
+    auto sphereBounds = bounds.reduced(28.0f, 24.0f);
+    const float diameter = juce::jmin(sphereBounds.getWidth(), sphereBounds.getHeight());
+    geometry.visible = diameter > 8.0f;
+
+    geometry.sphereArea = juce::Rectangle<float>(
+        sphereBounds.getCentreX() - diameter * 0.5f,
+        sphereBounds.getCentreY() - diameter * 0.5f,
+        diameter, diameter);
+    geometry.outerRadius = diameter * 0.5f;
+
+    // Knob-driven only: anything audio-reactive here would redraw the sphere layer every frame
+    geometry.hueBase = std::fmod(juce::jmap(s.driveAmount, 0.0f, 1.0f, 0.62f, 0.02f) + 1.0f, 1.0f);
+    geometry.brightness = juce::jmap(s.delayAmount, 0.0f, 1.0f, 0.35f, 0.92f);
+    geometry.saturation = juce::jmap(s.chaosAmount, 0.0f, 1.0f, 0.55f, 0.95f);
+
+    return geometry;
+}
+
+std::array<int, 3> OscVisualizerComponent::computeSphereKey() const noexcept
+{
+    const auto geometry = computeGeometry({}, state);
+    auto quantise = [](float v) { return juce::roundToInt(v * sphereKeySteps); };
+
+    return { quantise(geometry.hueBase), quantise(geometry.saturation), quantise(geometry.brightness) };
+}
+
+float OscVisualizerComponent::getLayerScale() const
+{
+    return juce::jlimit(1.0f, 4.0f, juce::Component::getApproximateScaleFactorForComponent(this));
+}
+
+void OscVisualizerComponent::resized()
+{
+    // Layers are rebuilt at the new size on the next paint
+    backgroundLayer = juce::Image();
+    sphereLayer = juce::Image();
+
+    detailBox.setBounds(getLocalBounds().reduced(detailBoxMargin)
+                            .removeFromTop(detailBoxHeight)
+                            .removeFromRight(detailBoxWidth));
+}
+
+//==============================================================================
+void OscVisualizerComponent::renderBackgroundLayer(float scale)
+{
+    const auto visualBounds = getLocalBounds().toFloat();
+    backgroundLayer = makeLayerImage(visualBounds, scale);
+
+    juce::Graphics g(backgroundLayer);
+    g.addTransform(juce::AffineTransform::scale(scale));
+    g.fillAll(juce::Colours::black);
+
+    juce::ColourGradient background(
+        juce::Colour::fromRGB(8, 10, 22), visualBounds.getBottomLeft(),
+        juce::Colour::fromRGB(18, 32, 60), visualBounds.getTopRight(), false);
+    g.setGradientFill(background);
+    g.fillRoundedRectangle(visualBounds, 20.0f);
+
+    g.setColour(juce::Colours::white.withAlpha(0.08f));
+    g.drawRoundedRectangle(visualBounds, 20.0f, 1.2f);
+}
+
+void OscVisualizerComponent::renderSphereLayer(const Geometry& geometry, float scale)
+{
+    if (!sphereLayer.isValid())
+        sphereLayer = makeLayerImage(geometry.bounds, scale);
+    else
+        sphereLayer.clear(sphereLayer.getBounds());
+
+    juce::Graphics g(sphereLayer);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
+    const auto& sphereArea = geometry.sphereArea;
+    const float hueBase = geometry.hueBase;
+    const float brightness = geometry.brightness;
+    const float saturation = geometry.saturation;
+
+    // The resting body only; the renderer adds the level glow and rim on top
+    juce::ColourGradient sphereGradient(
+        juce::Colour::fromHSV(hueBase, saturation, brightness, 1.0f),
+        sphereArea.getCentre(),
+        juce::Colour::fromHSV(std::fmod(hueBase + 0.11f, 1.0f),
+            juce::jmax(0.25f, saturation * 0.65f),
+            0.25f + brightness * 0.65f, 1.0f),
+        sphereArea.getBottomRight(), true);
+
+    g.setGradientFill(sphereGradient);
+    g.fillEllipse(sphereArea);
+}
+
+void OscVisualizerComponent::postDynamicFrame()
+{
+    auto& frame = dynamicRequests.getWriteBuffer();
+    frame.state = state;
+    frame.geometry = computeGeometry(getLocalBounds().toFloat(), state);
+    frame.snapshot = snapshots[(size_t)frontSnapshot];
+    frame.spectrum = spectrum;
+    frame.numSpectrumBands = numSpectrumBands;
+    frame.timeSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    frame.scale = getLayerScale();
+
+    dynamicRequests.publish();
+    renderer->notify();
+}
+
+void OscVisualizerComponent::paint(juce::Graphics& g)
+{
+    const auto bounds = getLocalBounds().toFloat();
+    const float scale = getLayerScale();
+
+    if (scale != layerScale)
+    {
+        layerScale = scale;
+        backgroundLayer = juce::Image();
+        sphereLayer = juce::Image();
+    }
+
+    if (!backgroundLayer.isValid())
+        renderBackgroundLayer(scale);
+
+    g.drawImage(backgroundLayer, bounds);
+
+    const auto geometry = computeGeometry(bounds, state);
+    if (!geometry.visible)
+        return;
+
+    const auto key = computeSphereKey();
+    if (!sphereLayer.isValid() || key != sphereKey)
+    {
+        sphereKey = key;
+        renderSphereLayer(geometry, scale);
+    }
+
+    g.drawImage(sphereLayer, bounds);
+
+    dynamicLayers.acquire();
+    const auto& dynamicLayer = dynamicLayers.getReadBuffer();
+    if (dynamicLayer.isValid())
+        g.drawImage(dynamicLayer, bounds);
 }
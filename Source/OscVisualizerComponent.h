@@ -1,30 +1,122 @@
 #pragma once
 #include <JuceHeader.h>
-#include <atomic>
-#include <vector>
+#include <array>
+#include <memory>
+#include "TripleBuffer.h"
 
+// Audio-reactive sphere: a static backdrop, a sphere that shifts colour with
+// the drive / delay / chaos knobs, and a fast layer with the level glow and
+// rim, the spectrum rays and the waveform wrapped around the sphere.
+//
+// Each layer is an offscreen image. The backdrop is redrawn only on resize,
+// and the sphere only when its quantised knob colours move. The fast layer
+// is drawn on a background thread from a copy of the latest state, so
+// paint() itself is just three image blits. A small detail box in the top
+// right corner picks the waveform's snapshot resolution.
 class OscVisualizerComponent : public juce::Component
 {
 public:
+    static constexpr int maxSnapshotResolution = 1024;
+    static constexpr int defaultSnapshotResolution = 160;
+    static constexpr int maxSpectrumBands = 64;
+
+    // One cycle-ish of the output, drawn around the sphere. Fixed capacity,
+    // so handing a new one over never allocates.
+    struct WaveformSnapshot
+    {
+        std::array<float, maxSnapshotResolution> points {};
+        int size = 0;
+    };
+
     OscVisualizerComponent();
     ~OscVisualizerComponent() override;
 
     void setVisualData(float smoothedLevel, float lowBand, float midBand, float highBand,
                        float delayFeedback, float glitchEnergy, float driveAmount,
-                       float delayAmount, float chaosAmount,
-                       const std::vector<float>& waveformSnapshot);
+                       float delayAmount, float chaosAmount);
+
+    // bands: 0..1, low to high frequency. rmsLevel sets how brightly they glow.
+    void setSpectrum(const float* bands, int numBands, float rmsLevel);
+
+    // Points per snapshot, clamped to 16..maxSnapshotResolution. The detail
+    // box sets this; a value it doesn't list leaves the box blank.
+    void setSnapshotResolution(int numPoints) noexcept;
+    int getSnapshotResolution() const noexcept { return snapshotResolution; }
+
+    // Double-buffered snapshot handoff: fill the back buffer returned by
+    // beginSnapshot(), then commitSnapshot() swaps it to the front for paint().
+    WaveformSnapshot& beginSnapshot() noexcept  { return snapshots[(size_t)(1 - frontSnapshot)]; }
+    void commitSnapshot() noexcept              { frontSnapshot = 1 - frontSnapshot; }
 
     void paint(juce::Graphics& g) override;
+    void resized() override;
 
 private:
-    float smoothedLevel = 0.0f;
-    float lowBand = 0.0f;
-    float midBand = 0.0f;
-    float highBand = 0.0f;
-    float delayFeedbackEnergy = 0.0f;
-    float glitchEnergy = 0.0f;
-    float driveAmount = 0.0f;
-    float delayAmount = 0.0f;
-    float chaosAmount = 0.0f;
-    std::vector<float> waveformSnapshot;
+    struct VisualState
+    {
+        float smoothedLevel = 0.0f;
+        float lowBand = 0.0f;
+        float midBand = 0.0f;
+        float highBand = 0.0f;
+        float delayFeedbackEnergy = 0.0f;
+        float glitchEnergy = 0.0f;
+        float driveAmount = 0.0f;
+        float delayAmount = 0.0f;
+        float chaosAmount = 0.0f;
+        float rmsLevel = 0.0f;
+    };
+
+    // Where the sphere sits and the colours derived from the state
+    struct Geometry
+    {
+        juce::Rectangle<float> bounds, sphereArea;
+        float outerRadius = 0.0f;
+        float hueBase = 0.0f, brightness = 0.0f, saturation = 0.0f;
+        bool visible = false;
+    };
+
+    // Everything the background thread needs to draw one fast-layer frame
+    struct DynamicFrame
+    {
+        VisualState state;
+        Geometry geometry;
+        WaveformSnapshot snapshot;
+        std::array<float, maxSpectrumBands> spectrum {};
+        int numSpectrumBands = 0;
+        double timeSeconds = 0.0;
+        float scale = 1.0f;
+    };
+
+    class Renderer;
+
+    VisualState state;
+
+    std::array<WaveformSnapshot, 2> snapshots;
+    int frontSnapshot = 0;
+    int snapshotResolution = defaultSnapshotResolution;
+
+    std::array<float, maxSpectrumBands> spectrum {};
+    int numSpectrumBands = 0;
+
+    juce::ComboBox detailBox;                       // item ids are point counts
+
+    // Cached layers (message thread)
+    juce::Image backgroundLayer, sphereLayer;
+    std::array<int, 3> sphereKey {};
+    float layerScale = 0.0f;
+
+    // Fast layer: requests go to the renderer, finished images come back
+    TripleBuffer<DynamicFrame> dynamicRequests;
+    TripleBuffer<juce::Image> dynamicLayers;
+    std::unique_ptr<Renderer> renderer;
+
+    static Geometry computeGeometry(juce::Rectangle<float> bounds, const VisualState& s) noexcept;
+    std::array<int, 3> computeSphereKey() const noexcept;
+    float getLayerScale() const;
+
+    void renderBackgroundLayer(float scale);
+    void renderSphereLayer(const Geometry& geometry, float scale);
+    void postDynamicFrame();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscVisualizerComponent)
 };
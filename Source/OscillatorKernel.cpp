@@ -0,0 +1,111 @@
+#include "OscillatorKernel.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+OscillatorKernel::OscillatorKernel() = default;
+
+void OscillatorKernel::setLaneRatio(int lane, float ratio) noexcept
+{
+    jassert(juce::isPositiveAndBelow(lane, laneCount));
+    ratios[(size_t)lane] = ratio;
+}
+
+void OscillatorKernel::setLanePhase(int lane, juce::uint32 phase) noexcept
+{
+    jassert(juce::isPositiveAndBelow(lane, laneCount));
+    phases[(size_t)lane] = phase;
+}
+
+void OscillatorKernel::resetPhases() noexcept
+{
+    phases.fill(0);
+}
+
+// render() gathers from every mip level through one pointer to the first
+// table, stepping tableSize + 1 floats per level, so the set must be packed
+static_assert(sizeof(WavetableOscillator::TableSet)
+                  == (size_t)WavetableOscillator::numMipLevels * (WavetableOscillator::tableSize + 1) * sizeof(float),
+              "mip levels must be contiguous with no padding between tables");
+
+void OscillatorKernel::render(const WavetableOscillator::TableSet& tables,
+                              const float* baseIncrements, int numSamples, float* output) noexcept
+{
+    const float* base = tables[0].samples.data();
+    const auto tableSize = simd::broadcast((float)WavetableOscillator::tableSize);
+    const auto levelStride = simd::broadcast((float)(WavetableOscillator::tableSize + 1));
+    const auto cycleScale = simd::broadcast(PhaseAccumulator::cycleScaleF);
+    const auto maxIncrement = simd::broadcast(PhaseAccumulator::maxIncrement);
+    const auto fractionMask = simd::broadcastInt(WavetableOscillator::fractionMask);
+    const auto fractionScale = simd::broadcast(WavetableOscillator::fractionScale);
+    const auto ratio = simd::load(ratios.data());
+    auto phase = simd::loadInt(phases.data());
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto inc = simd::min(simd::mul(simd::broadcast(baseIncrements[i]), ratio), maxIncrement);
+        phase = simd::addInt(phase, simd::truncate(simd::mul(inc, cycleScale)));
+
+        const auto level = simd::octaveAbove(simd::mul(inc, tableSize), WavetableOscillator::numMipLevels - 1);
+        const auto index = simd::toFloat(simd::shiftRight<WavetableOscillator::fractionBits>(phase));
+        const auto frac = simd::mul(simd::toFloat(simd::andInt(phase, fractionMask)), fractionScale);
+
+        const auto offset = simd::truncate(simd::add(simd::mul(simd::toFloat(level), levelStride), index));
+        const auto a = simd::gather(base, offset);
+        const auto b = simd::gather(base + 1, offset);
+
+        simd::store(output + (size_t)i * laneCount, simd::add(a, simd::mul(frac, simd::sub(b, a))));
+    }
+
+    simd::storeInt(phases.data(), phase);
+}
+
+void OscillatorKernel::renderScalar(const WavetableOscillator::TableSet& tables,
+                                    const float* baseIncrements, int numSamples, float* output) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int lane = 0; lane < laneCount; ++lane)
+        {
+            const float inc = juce::jmin(baseIncrements[i] * ratios[(size_t)lane], PhaseAccumulator::maxIncrement);
+            auto& ph = phases[(size_t)lane];
+            ph += (juce::uint32)(juce::int32)(inc * PhaseAccumulator::cycleScaleF);
+
+            output[(size_t)i * laneCount + (size_t)lane] = WavetableOscillator::lookup(tables, ph, inc);
+        }
+    }
+}
+
+bool OscillatorKernel::matchesScalarReference()
+{
+    auto tables = std::make_unique<WavetableOscillator::TableSet>();
+    for (int level = 0; level < WavetableOscillator::numMipLevels; ++level)
+    {
+        auto& samples = (*tables)[(size_t)level].samples;
+        for (size_t n = 0; n < samples.size(); ++n)
+            samples[n] = std::sin(juce::MathConstants<float>::twoPi * (float)(n * (size_t)(level + 1)) / (float)WavetableOscillator::tableSize);
+    }
+
+    constexpr int numSamples = 512;
+    std::vector<float> increments((size_t)numSamples);
+    for (int i = 0; i < numSamples; ++i)
+        increments[(size_t)i] = 0.0005f + 0.2f * (float)i / (float)numSamples;
+
+    OscillatorKernel vectorised, scalar;
+    for (int lane = 0; lane < laneCount; ++lane)
+    {
+        const float ratio = 0.5f + 0.37f * (float)lane;
+        vectorised.setLaneRatio(lane, ratio);
+        scalar.setLaneRatio(lane, ratio);
+    }
+
+    std::vector<float> a((size_t)(numSamples * laneCount)), b(a.size());
+    vectorised.render(*tables, increments.data(), numSamples, a.data());
+    scalar.renderScalar(*tables, increments.data(), numSamples, b.data());
+
+    for (size_t n = 0; n < a.size(); ++n)
+        if (std::abs(a[n] - b[n]) > scalarTolerance)
+            return false;
+
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "SimdOps.h"
+#include "WavetableOscillator.h"
+
+// Renders several wavetable oscillators that share one base phase increment
+// (each lane runs at its own ratio of it) in a single SIMD pass per sample.
+// Lane phases are 32-bit fixed-point (see PhaseAccumulator), so they wrap
+// for free in the integer add.
+//
+// Output is sample-major: sample i of lane n lands at output[i * laneCount + n],
+// so each sample is written with one vector store. Unused lanes are spare and
+// simply run at ratio 0.
+class OscillatorKernel
+{
+public:
+    static constexpr int laneCount = simd::laneCount;
+
+    // Max difference between render() and renderScalar() for identical input.
+    // Both paths use the same table maths, so this only covers reassociation.
+    static constexpr float scalarTolerance = 1.0e-5f;
+
+    OscillatorKernel();
+
+    void setLaneRatio(int lane, float ratio) noexcept;
+    void setLanePhase(int lane, juce::uint32 phase) noexcept;
+    void resetPhases() noexcept;
+
+    // baseIncrements: phase increment per sample in cycles, numSamples long.
+    // output must hold numSamples * laneCount floats.
+    void render(const WavetableOscillator::TableSet& tables,
+                const float* baseIncrements, int numSamples, float* output) noexcept;
+
+    // Reference path, one lane at a time through WavetableOscillator::lookup.
+    void renderScalar(const WavetableOscillator::TableSet& tables,
+                      const float* baseIncrements, int numSamples, float* output) noexcept;
+
+    // Debug self-check: runs both paths over a synthetic table set and
+    // returns true if they agree within scalarTolerance.
+    static bool matchesScalarReference();
+
+private:
+    alignas(32) std::array<juce::uint32, laneCount> phases {};
+    alignas(32) std::array<float, laneCount> ratios {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscillatorKernel)
+};
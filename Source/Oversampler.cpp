@@ -0,0 +1,144 @@
+#include "Oversampler.h"
+
+namespace
+{
+    // Non-zero taps of each half-band, first half (the filter is symmetric):
+    // h[0], h[2], ... h[2K - 2]. Kaiser-windowed sinc, normalised so each
+    // polyphase branch has unity DC gain; the centre tap is 0.5.
+    constexpr float firstStageTaps[Oversampler::firstStageHalfLength] =
+    {
+        -5.160821733e-05f, 2.894114118e-04f, -8.594591784e-04f, 1.991966847e-03f,
+        -3.996564758e-03f, 7.283358184e-03f, -1.242151330e-02f, 2.030776204e-02f,
+        -3.267419363e-02f, 5.388155736e-02f, -9.996114758e-02f, 3.162104308e-01f
+    };
+
+    constexpr float laterStageTaps[Oversampler::laterStageHalfLength] =
+    {
+        2.098435739e-04f, -4.318746999e-03f, 2.156205938e-02f, -7.334108428e-02f, 3.058879283e-01f
+    };
+
+    // Symmetric FIR over the 2K non-zero taps; window[0] is the newest sample.
+    template <int K>
+    inline float convolveHalfband(const float* taps, const float* window) noexcept
+    {
+        float sum = 0.0f;
+        for (int j = 0; j < K; ++j)
+            sum += taps[j] * (window[j] + window[2 * K - 1 - j]);
+        return sum;
+    }
+
+    template <int K>
+    void upsampleStage(Oversampler::StageState& state, const float* taps,
+                       const float* input, float* output, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            state.upHistory.push(input[i]);
+            const float* window = state.upHistory.window();
+
+            // Zero-stuffed input with gain 2: the even phase is the FIR, the
+            // odd phase only meets the 0.5 centre tap.
+            output[2 * i] = 2.0f * convolveHalfband<K>(taps, window);
+            output[2 * i + 1] = window[K - 1];
+        }
+    }
+
+    template <int K>
+    void downsampleStage(Oversampler::StageState& state, const float* taps,
+                         const float* input, float* output, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            state.downEven.push(input[2 * i]);
+            state.downOdd.push(input[2 * i + 1]);
+
+            output[i] = convolveHalfband<K>(taps, state.downEven.window())
+                      + 0.5f * state.downOdd.window()[K];
+        }
+    }
+}
+
+//==============================================================================
+void Oversampler::prepare(int maxBlockSize)
+{
+    maxBlock = juce::jmax(1, maxBlockSize);
+
+    // Intermediate rates for a full 8x pass: 2n and 4n
+    scratch.assign((size_t)(maxBlock * (maxFactor - 2)), 0.0f);
+}
+
+void Oversampler::setFactorLog2(int newFactorLog2) noexcept
+{
+    factorLog2 = juce::jlimit(0, maxFactorLog2, newFactorLog2);
+}
+
+float Oversampler::getLatencySamples(int log2Factor) noexcept
+{
+    // Each stage delays by (2K - 1) samples at its output rate on the way up
+    // and again on the way down.
+    float latency = 0.0f;
+    for (int stage = 0; stage < log2Factor; ++stage)
+    {
+        const int k = stage == 0 ? firstStageHalfLength : laterStageHalfLength;
+        latency += (float)(2 * (2 * k - 1)) / (float)(2 << stage);
+    }
+    return latency;
+}
+
+void Oversampler::upsample(ChannelState& state, const float* input, float* output, int numSamples) noexcept
+{
+    jassert(numSamples <= maxBlock);
+
+    if (factorLog2 == 0)
+    {
+        if (output != input)
+            juce::FloatVectorOperations::copy(output, input, numSamples);
+        return;
+    }
+
+    float* intermediate[2] = { scratch.data(), scratch.data() + 2 * maxBlock };
+    const float* src = input;
+    int n = numSamples;
+
+    for (int stage = 0; stage < factorLog2; ++stage)
+    {
+        float* dst = stage == factorLog2 - 1 ? output : intermediate[stage];
+
+        if (stage == 0)
+            upsampleStage<firstStageHalfLength>(state.stages[stage], firstStageTaps, src, dst, n);
+        else
+            upsampleStage<laterStageHalfLength>(state.stages[stage], laterStageTaps, src, dst, n);
+
+        src = dst;
+        n *= 2;
+    }
+}
+
+void Oversampler::downsample(ChannelState& state, const float* input, float* output, int numSamples) noexcept
+{
+    jassert(numSamples <= maxBlock);
+
+    if (factorLog2 == 0)
+    {
+        if (output != input)
+            juce::FloatVectorOperations::copy(output, input, numSamples);
+        return;
+    }
+
+    float* intermediate[2] = { scratch.data(), scratch.data() + 2 * maxBlock };
+    const float* src = input;
+    int n = numSamples << (factorLog2 - 1);
+
+    for (int stage = factorLog2 - 1; stage >= 0; --stage)
+    {
+        float* dst = stage == 0 ? output : intermediate[stage - 1];
+
+        if (stage == 0)
+            downsampleStage<firstStageHalfLength>(state.stages[stage], firstStageTaps, src, dst, n);
+        else
+            downsampleStage<laterStageHalfLength>(state.stages[stage], laterStageTaps, src, dst, n);
+
+        src = dst;
+        n /= 2;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "SpscRingBuffer.h"
+
+// Lock-free handoff of a fixed set of float parameters from one producer
+// thread (the UI) to the audio thread. Nothing on the audio thread can post
+// a change: there is no entry point for host automation yet.
+//
+// Every parameter has an atomic latest value that any thread can read
+// wait-free, e.g. the GUI for display or the message-thread wavetable
+// builder. Each set() also queues a change stamped with its arrival time, so
+// the audio thread can apply it at the matching offset inside a block rather
+// than at the top of it. If the queue ever fills, the value is still
+// published and the overflow is flagged; the audio thread then throws the
+// queued changes away and resyncs from the latest values instead.
+//
+// ParamId is an enum whose values index the parameters, 0 to NumParams - 1.
+template <typename ParamId, int NumParams>
+class ParameterBus
+{
+public:
+    static constexpr int numParams = NumParams;
+
+    struct Change
+    {
+        double arrivalMs = 0.0;         // juce::Time::getMillisecondCounterHiRes()
+        ParamId id {};
+        float value = 0.0f;
+    };
+
+    ParameterBus()
+    {
+        for (auto& v : values)
+            v.store(0.0f, std::memory_order_relaxed);
+    }
+
+    // Not real-time safe, and neither side may be running.
+    void prepare(int queueSize)
+    {
+        changes.prepare(queueSize);
+        overflowed.store(false, std::memory_order_relaxed);
+    }
+
+    // ===== Producer side =====
+    void set(ParamId id, float value) noexcept
+    {
+        values[index(id)].store(value, std::memory_order_relaxed);
+
+        Change change;
+        change.arrivalMs = juce::Time::getMillisecondCounterHiRes();
+        change.id = id;
+        change.value = value;
+
+        if (changes.push(&change, 1) == 0)
+            overflowed.store(true, std::memory_order_release);
+    }
+
+    // ===== Any thread =====
+    float get(ParamId id) const noexcept    { return values[index(id)].load(std::memory_order_relaxed); }
+
+    // ===== Consumer side =====
+    // Returns how many changes were copied into dest, oldest first.
+    int popChanges(Change* dest, int maxChanges) noexcept   { return changes.pop(dest, maxChanges); }
+
+    // True once after changes were dropped; the consumer should discard the
+    // queue and re-read every value with get().
+    bool consumeOverflow() noexcept         { return overflowed.exchange(false, std::memory_order_acquire); }
+
+    // Drops every queued change. Anything already queued is older than, or
+    // the same as, what get() returns afterwards.
+    void discardChanges() noexcept          { changes.discardAll(); }
+
+private:
+    std::array<std::atomic<float>, NumParams> values;
+    SpscRingBuffer<Change> changes;
+    std::atomic<bool> overflowed { false };
+
+    static size_t index(ParamId id) noexcept
+    {
+        jassert((int)id >= 0 && (int)id < NumParams);
+        return (size_t)id;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterBus)
+};
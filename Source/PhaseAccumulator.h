@@ -0,0 +1,38 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+
+// 32-bit fixed-point phase: the full uint32 range is exactly one cycle, so
+// wrapping is the free integer overflow and the phase never drifts, however
+// long the session runs. Shared by every oscillator lane and LFO.
+struct PhaseAccumulator
+{
+    static constexpr double cycleScale = 4294967296.0;            // 2^32
+    static constexpr float cycleScaleF = 4294967296.0f;
+    static constexpr float invCycleScale = 1.0f / 4294967296.0f;
+
+    // Increments are capped just below Nyquist so they fit a signed 32-bit
+    // conversion, which is all SSE2 offers.
+    static constexpr float maxIncrement = 0.4999f;
+
+    juce::uint32 phase = 0;
+
+    static inline juce::uint32 toIncrement(float cyclesPerSample) noexcept
+    {
+        return (juce::uint32)(juce::int32)(juce::jlimit(0.0f, maxIncrement, cyclesPerSample) * cycleScaleF);
+    }
+
+    inline void advance(juce::uint32 increment) noexcept        { phase += increment; }
+    inline void advance(float cyclesPerSample) noexcept         { phase += toIncrement(cyclesPerSample); }
+
+    inline float getNormalised() const noexcept                 { return (float)phase * invCycleScale; }
+    inline float getRadians() const noexcept                    { return getNormalised() * juce::MathConstants<float>::twoPi; }
+
+    inline void setNormalised(float cycles) noexcept
+    {
+        const double wrapped = (double)cycles - std::floor((double)cycles);
+        phase = (juce::uint32)(juce::uint64)(wrapped * cycleScale);
+    }
+
+    inline void reset() noexcept                                { phase = 0; }
+};
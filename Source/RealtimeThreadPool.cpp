@@ -0,0 +1,190 @@
+#include "RealtimeThreadPool.h"
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <immintrin.h>
+ #define SYNTH_CPU_PAUSE() _mm_pause()
+#else
+ #define SYNTH_CPU_PAUSE() std::this_thread::yield()
+#endif
+
+namespace
+{
+    constexpr int parkTimeoutMs = 100;
+}
+
+//==============================================================================
+class RealtimeThreadPool::Worker : public juce::Thread
+{
+public:
+    Worker(RealtimeThreadPool& ownerPool, int participantIndex)
+        : juce::Thread("Voice render " + juce::String(participantIndex)),
+          pool(ownerPool),
+          participant(participantIndex)
+    {
+    }
+
+    void run() override
+    {
+        pool.workerLoop(*this, participant);
+    }
+
+    juce::WaitableEvent wake;
+
+private:
+    RealtimeThreadPool& pool;
+    const int participant;
+};
+
+//==============================================================================
+RealtimeThreadPool::RealtimeThreadPool() = default;
+
+RealtimeThreadPool::~RealtimeThreadPool()
+{
+    stop();
+}
+
+void RealtimeThreadPool::start(int newNumWorkers, int blockSize, double sampleRate)
+{
+    stop();
+
+    numWorkers = juce::jlimit(0, maxWorkers, newNumWorkers);
+
+    // Workers busy-wait for the whole callback, so they need the same
+    // scheduling class as the audio thread or a preempted one stalls run()
+    const auto options = juce::Thread::RealtimeOptions{}
+                             .withApproximateAudioProcessingTime(juce::jmax(1, blockSize), sampleRate);
+
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        workers[w] = std::make_unique<Worker>(*this, w + 1);
+
+        // Falls back when the process may not raise real-time threads
+        // (e.g. Linux without rtprio); run() stays correct either way
+        if (!workers[w]->startRealtimeThread(options))
+            workers[w]->startThread(juce::Thread::Priority::highest);
+    }
+}
+
+void RealtimeThreadPool::stop()
+{
+    spinning.store(false);
+
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        workers[w]->signalThreadShouldExit();
+        workers[w]->wake.signal();
+    }
+
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        workers[w]->stopThread(1000);
+        workers[w].reset();
+    }
+
+    numWorkers = 0;
+}
+
+void RealtimeThreadPool::beginCallback() noexcept
+{
+    if (numWorkers == 0)
+        return;
+
+    spinning.store(true);
+
+    for (int w = 0; w < numWorkers; ++w)
+        workers[w]->wake.signal();
+}
+
+void RealtimeThreadPool::endCallback() noexcept
+{
+    spinning.store(false);
+}
+
+//==============================================================================
+void RealtimeThreadPool::run(Job& job, int numTasks) noexcept
+{
+    if (numTasks <= 0)
+        return;
+
+    if (numWorkers == 0 || numTasks == 1 || !spinning.load())
+    {
+        for (int t = 0; t < numTasks; ++t)
+            job.runTask(t);
+        return;
+    }
+
+    // Close the previous job and wait for any worker still scanning its
+    // ranges before they are rewritten.
+    generation.fetch_add(1);
+    while (busyWorkers.load() != 0)
+        SYNTH_CPU_PAUSE();
+
+    currentJob = &job;
+    numParticipants = juce::jmin(numWorkers + 1, numTasks);
+
+    for (int p = 0; p < numParticipants; ++p)
+    {
+        ranges[p].next.store(numTasks * p / numParticipants, std::memory_order_relaxed);
+        ranges[p].end = numTasks * (p + 1) / numParticipants;
+    }
+
+    tasksRemaining.store(numTasks);
+    generation.fetch_add(1);
+
+    participate(0);
+
+    while (tasksRemaining.load(std::memory_order_acquire) != 0)
+        SYNTH_CPU_PAUSE();
+}
+
+void RealtimeThreadPool::participate(int participant) noexcept
+{
+    // Own range first, then steal from the others in turn.
+    const int first = participant % numParticipants;
+
+    for (int k = 0; k < numParticipants; ++k)
+    {
+        auto& range = ranges[(first + k) % numParticipants];
+        while (runNextTask(range)) {}
+    }
+}
+
+bool RealtimeThreadPool::runNextTask(TaskRange& range) noexcept
+{
+    const int task = range.next.fetch_add(1, std::memory_order_relaxed);
+    if (task >= range.end)
+        return false;
+
+    currentJob->runTask(task);
+    tasksRemaining.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void RealtimeThreadPool::workerLoop(Worker& worker, int participant)
+{
+    juce::uint32 lastGeneration = generation.load();
+
+    while (!worker.threadShouldExit())
+    {
+        if (!spinning.load(std::memory_order_relaxed))
+        {
+            worker.wake.wait(parkTimeoutMs);
+            continue;
+        }
+
+        const auto g = generation.load();
+        if (g == lastGeneration || (g & 1u) != 0)
+        {
+            SYNTH_CPU_PAUSE();
+            continue;
+        }
+
+        busyWorkers.fetch_add(1);
+        if (generation.load() == g)
+            participate(participant);
+        busyWorkers.fetch_sub(1);
+
+        lastGeneration = g;
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+
+// Small fork/join pool for splitting audio-callback work across cores.
+//
+// Workers are started outside the callback (prepareToPlay) and park on an
+// event between callbacks. beginCallback() wakes them and they spin until
+// endCallback(), so dispatching a job inside the callback costs a couple of
+// atomics rather than a kernel wake-up. The price is that every worker keeps
+// a core busy for the whole callback, so owners should let users opt out and
+// start zero workers.
+//
+// Workers run as real-time threads with the callback's period where the OS
+// allows it. They aren't pinned: JUCE exposes no core topology, and masks
+// over logical CPU numbers can put two workers on SMT siblings of one core
+// or on the core the audio thread uses. The calling thread always takes part
+// in run(), which means a worker that wakes late only costs parallelism, never
+// correctness, and with zero workers run() is a plain loop.
+//
+// Each participant owns a contiguous range of task indices and drains it
+// from the front; once empty it steals from the other ranges. Tasks must be
+// independent of each other; ordering is left to the caller (see
+// VoiceEngine::render, which mixes per-block results in a fixed order).
+class RealtimeThreadPool
+{
+public:
+    struct Job
+    {
+        virtual ~Job() = default;
+        virtual void runTask(int taskIndex) noexcept = 0;
+    };
+
+    static constexpr int maxWorkers = 15;
+
+    RealtimeThreadPool();
+    ~RealtimeThreadPool();
+
+    // Not real-time safe: (re)starts the given number of worker threads,
+    // scheduled for callbacks of blockSize samples at sampleRate.
+    void start(int numWorkers, int blockSize, double sampleRate);
+    void stop();
+
+    int getNumWorkers() const noexcept { return numWorkers; }
+
+    // Called from the audio thread around the section that calls run().
+    void beginCallback() noexcept;
+    void endCallback() noexcept;
+
+    // Runs job.runTask(0 .. numTasks - 1) and returns once every task is done.
+    void run(Job& job, int numTasks) noexcept;
+
+private:
+    class Worker;
+
+    struct alignas(64) TaskRange
+    {
+        std::atomic<int> next { 0 };
+        int end = 0;
+    };
+
+    static constexpr int maxParticipants = maxWorkers + 1;
+
+    std::unique_ptr<Worker> workers[maxWorkers];
+    int numWorkers = 0;
+
+    // Even generation: a job is published. Odd: the caller is rewriting the
+    // ranges and waits for busyWorkers to drain before touching them.
+    alignas(64) std::atomic<juce::uint32> generation { 0 };
+    alignas(64) std::atomic<int> busyWorkers { 0 };
+    alignas(64) std::atomic<int> tasksRemaining { 0 };
+    std::atomic<bool> spinning { false };
+
+    Job* currentJob = nullptr;
+    int numParticipants = 1;
+    TaskRange ranges[maxParticipants];
+
+    void workerLoop(Worker& worker, int participant);
+    void participate(int participant) noexcept;
+    bool runNextTask(TaskRange& range) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeThreadPool)
+};
@@ -0,0 +1,81 @@
+#include "ScopeCapture.h"
+#include <cstring>
+
+void ScopeCapture::reset() noexcept
+{
+    history.fill(0.0f);
+    written = 0;
+    lastPublished = 0;
+    previous = 0.0f;
+    crossingHead = 0;
+    numCrossings = 0;
+}
+
+void ScopeCapture::push(const float* samples, int numSamples) noexcept
+{
+    jassert(numSamples <= historySize - frameSize);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float current = samples[i];
+        const juce::uint64 position = written + (juce::uint64)i;
+
+        if (previous < 0.0f && current >= 0.0f)
+        {
+            const int newest = (crossingHead + maxCrossings - 1) % maxCrossings;
+            if (numCrossings == 0 || position - crossings[(size_t)newest] >= (juce::uint64)minCrossingSpacing)
+            {
+                crossings[(size_t)crossingHead] = position;
+                crossingHead = (crossingHead + 1) % maxCrossings;
+                numCrossings = juce::jmin(numCrossings + 1, maxCrossings);
+            }
+        }
+
+        previous = current;
+    }
+
+    // Append to the history in at most two copies
+    const int start = (int)(written & (juce::uint64)historyMask);
+    const int first = juce::jmin(numSamples, historySize - start);
+    std::memcpy(history.data() + start, samples, (size_t)first * sizeof(float));
+    std::memcpy(history.data(), samples + first, (size_t)(numSamples - first) * sizeof(float));
+    written += (juce::uint64)numSamples;
+
+    if (written < (juce::uint64)frameSize || written - lastPublished < (juce::uint64)publishInterval)
+        return;
+
+    lastPublished = written;
+
+    // Newest crossing with a whole frame after it that's still in the history
+    const juce::uint64 latestStart = written - (juce::uint64)frameSize;
+    const juce::uint64 earliestStart = written > (juce::uint64)historySize ? written - (juce::uint64)historySize : 0;
+
+    for (int n = 1; n <= numCrossings; ++n)
+    {
+        const auto crossing = crossings[(size_t)((crossingHead + maxCrossings - n) % maxCrossings)];
+
+        if (crossing < earliestStart)
+            break;
+
+        if (crossing <= latestStart)
+        {
+            publish(crossing, true);
+            return;
+        }
+    }
+
+    publish(latestStart, false);
+}
+
+void ScopeCapture::publish(juce::uint64 start, bool triggered) noexcept
+{
+    Frame& frame = frames.getWriteBuffer();
+    const int begin = (int)(start & (juce::uint64)historyMask);
+    const int first = juce::jmin(frameSize, historySize - begin);
+
+    std::memcpy(frame.samples.data(), history.data() + begin, (size_t)first * sizeof(float));
+    std::memcpy(frame.samples.data() + first, history.data(), (size_t)(frameSize - first) * sizeof(float));
+    frame.triggered = triggered;
+
+    frames.publish();
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "TripleBuffer.h"
+
+// Trigger-aligned oscilloscope frames, handed from the audio thread to the
+// message thread without locks or tearing.
+//
+// The audio side appends its output to a private history and notes rising
+// zero crossings as it goes. Every publishInterval samples it copies out the
+// frame that starts at the newest crossing still followed by a full frame
+// of audio, and publishes it through a triple buffer. The GUI then only has
+// to acquire(): the frame it reads is already aligned, and stays untouched
+// until its next acquire(). With no usable crossing (silence, DC, very low
+// notes) the newest frameSize samples are published free-running instead.
+class ScopeCapture
+{
+public:
+    static constexpr int frameSize = 2048;
+
+    struct Frame
+    {
+        std::array<float, frameSize> samples {};
+        bool triggered = false;     // samples[0] is the first sample at or above zero after a negative one
+    };
+
+    ScopeCapture() = default;
+
+    // ===== Audio thread =====
+    void reset() noexcept;
+    void push(const float* samples, int numSamples) noexcept;
+
+    // ===== Message thread =====
+    // Returns true if a newer frame was picked up.
+    bool acquire() noexcept                   { return frames.acquire(); }
+    const Frame& getFrame() const noexcept    { return frames.getReadBuffer(); }
+
+private:
+    static constexpr int historySize = frameSize * 2;
+    static constexpr int historyMask = historySize - 1;
+    static constexpr int publishInterval = 512;
+
+    // Crossings closer together than this are skipped, so the list always
+    // reaches back over the whole history, however high the note.
+    static constexpr int maxCrossings = 64;
+    static constexpr int minCrossingSpacing = historySize / maxCrossings;
+
+    std::array<float, historySize> history {};
+    juce::uint64 written = 0;
+    juce::uint64 lastPublished = 0;
+    float previous = 0.0f;
+
+    std::array<juce::uint64, maxCrossings> crossings {};
+    int crossingHead = 0;
+    int numCrossings = 0;
+
+    TripleBuffer<Frame> frames;
+
+    void publish(juce::uint64 start, bool triggered) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScopeCapture)
+};
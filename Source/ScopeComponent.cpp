@@ -0,0 +1,73 @@
+#include "ScopeComponent.h"
+
+ScopeComponent::ScopeComponent()
+{
+    setOpaque(true);
+
+    // Top edge, bottom edge and a close: a type tag plus coordinates each
+    envelope.preallocateSpace(6 * maxColumns + 8);
+}
+
+void ScopeComponent::setFrame(const ScopeCapture::Frame& frame)
+{
+    samples = frame.samples;
+    repaint();
+}
+
+void ScopeComponent::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    const auto bounds = getLocalBounds().toFloat();
+    g.setColour(juce::Colours::white.withAlpha(0.08f));
+    g.drawRoundedRectangle(bounds.reduced(0.5f), 8.0f, 1.0f);
+
+    const int width = getWidth();
+    if (width <= 0)
+        return;
+
+    // One sample per pixel, as far as the frame reaches
+    const int span = juce::jmin(width, ScopeCapture::frameSize);
+    const int numColumns = juce::jmin(maxColumns, span);
+    const float columnWidth = bounds.getWidth() / (float)numColumns;
+    const float top = bounds.getY();
+    const float bottom = bounds.getBottom();
+
+    for (int c = 0; c < numColumns; ++c)
+    {
+        const int first = c * span / numColumns;
+        const int end = juce::jmax(first + 1, (c + 1) * span / numColumns);
+
+        float lo = samples[(size_t)first];
+        float hi = lo;
+        for (int i = first + 1; i < end; ++i)
+        {
+            lo = juce::jmin(lo, samples[(size_t)i]);
+            hi = juce::jmax(hi, samples[(size_t)i]);
+        }
+
+        columnMin[(size_t)c] = juce::jmap(juce::jlimit(-1.0f, 1.0f, lo), -1.0f, 1.0f, bottom, top);
+        columnMax[(size_t)c] = juce::jmap(juce::jlimit(-1.0f, 1.0f, hi), -1.0f, 1.0f, bottom, top);
+    }
+
+    // Out along the maxima and back along the minima. Where a column holds
+    // a single sample the two edges coincide and this is a plain trace.
+    envelope.clear();
+    for (int c = 0; c < numColumns; ++c)
+    {
+        const float x = bounds.getX() + ((float)c + 0.5f) * columnWidth;
+        if (c == 0)
+            envelope.startNewSubPath(x, columnMax[(size_t)c]);
+        else
+            envelope.lineTo(x, columnMax[(size_t)c]);
+    }
+
+    for (int c = numColumns - 1; c >= 0; --c)
+        envelope.lineTo(bounds.getX() + ((float)c + 0.5f) * columnWidth, columnMin[(size_t)c]);
+
+    envelope.closeSubPath();
+
+    g.setColour(juce::Colours::white.withAlpha(0.85f));
+    g.fillPath(envelope);
+    g.strokePath(envelope, juce::PathStrokeType(1.5f));
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "ScopeCapture.h"
+
+// Oscilloscope strip for the trigger-aligned frames from ScopeCapture.
+//
+// The visible span is folded into at most maxColumns columns, and each
+// column is drawn as the min..max of the samples it covers. The path's
+// vertex count is therefore bounded by maxColumns rather than by the
+// width in pixels, and fast transients within a column still show. The
+// component is opaque, so a new frame repaints only the scope strip.
+class ScopeComponent : public juce::Component
+{
+public:
+    static constexpr int maxColumns = 512;
+
+    ScopeComponent();
+    ~ScopeComponent() override = default;
+
+    // Copies the frame and repaints.
+    void setFrame(const ScopeCapture::Frame& frame);
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    std::array<float, ScopeCapture::frameSize> samples {};
+    std::array<float, maxColumns> columnMin {};
+    std::array<float, maxColumns> columnMax {};
+    juce::Path envelope;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScopeComponent)
+};
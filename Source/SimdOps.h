@@ -0,0 +1,157 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cstdint>
+#include <cstring>
+
+// Thin wrapper over the few vector operations the DSP kernels need.
+// AVX2 gives 8 lanes, SSE2 gives 4, and anything else falls back to a plain
+// 4-element array so the kernels still compile (and auto-vectorise) elsewhere.
+// Define SYNTH_FORCE_SCALAR to build the fallback on x86 too.
+#if defined (__AVX2__) && ! defined (SYNTH_FORCE_SCALAR)
+ #define SYNTH_SIMD_AVX2 1
+ #include <immintrin.h>
+#elif ! defined (SYNTH_FORCE_SCALAR) && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+ #define SYNTH_SIMD_SSE2 1
+ #include <emmintrin.h>
+#else
+ #define SYNTH_SIMD_SCALAR 1
+#endif
+
+namespace simd
+{
+#if SYNTH_SIMD_AVX2
+    using FloatReg = __m256;
+    using IntReg = __m256i;
+    constexpr int laneCount = 8;
+
+    inline FloatReg load(const float* p) noexcept               { return _mm256_loadu_ps(p); }
+    inline void store(float* p, FloatReg v) noexcept            { _mm256_storeu_ps(p, v); }
+    inline FloatReg broadcast(float v) noexcept                 { return _mm256_set1_ps(v); }
+    inline FloatReg add(FloatReg a, FloatReg b) noexcept        { return _mm256_add_ps(a, b); }
+    inline FloatReg sub(FloatReg a, FloatReg b) noexcept        { return _mm256_sub_ps(a, b); }
+    inline FloatReg mul(FloatReg a, FloatReg b) noexcept        { return _mm256_mul_ps(a, b); }
+    inline FloatReg div(FloatReg a, FloatReg b) noexcept        { return _mm256_div_ps(a, b); }
+    inline FloatReg min(FloatReg a, FloatReg b) noexcept        { return _mm256_min_ps(a, b); }
+    inline FloatReg max(FloatReg a, FloatReg b) noexcept        { return _mm256_max_ps(a, b); }
+    inline bool allEqual(FloatReg a, FloatReg b) noexcept       { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)) == 0xff; }
+
+    inline IntReg truncate(FloatReg v) noexcept                 { return _mm256_cvttps_epi32(v); }
+    inline FloatReg toFloat(IntReg v) noexcept                  { return _mm256_cvtepi32_ps(v); }
+
+    inline IntReg loadInt(const std::uint32_t* p) noexcept      { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    inline void storeInt(std::uint32_t* p, IntReg v) noexcept   { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    inline IntReg broadcastInt(std::uint32_t v) noexcept        { return _mm256_set1_epi32((int)v); }
+    inline IntReg addInt(IntReg a, IntReg b) noexcept           { return _mm256_add_epi32(a, b); }
+    inline IntReg andInt(IntReg a, IntReg b) noexcept           { return _mm256_and_si256(a, b); }
+    template <int bits>
+    inline IntReg shiftRight(IntReg v) noexcept                 { return _mm256_srli_epi32(v, bits); }
+
+    // floor(log2(v)) + 1 taken from the exponent bits, clamped to [0, maxValue].
+    inline IntReg octaveAbove(FloatReg v, int maxValue) noexcept
+    {
+        auto e = _mm256_srli_epi32(_mm256_castps_si256(v), 23);
+        e = _mm256_sub_epi32(_mm256_and_si256(e, _mm256_set1_epi32(0xff)), _mm256_set1_epi32(126));
+        return _mm256_min_epi32(_mm256_max_epi32(e, _mm256_setzero_si256()), _mm256_set1_epi32(maxValue));
+    }
+
+    inline FloatReg gather(const float* base, IntReg offsets) noexcept
+    {
+        return _mm256_i32gather_ps(base, offsets, 4);
+    }
+
+#elif SYNTH_SIMD_SSE2
+    using FloatReg = __m128;
+    using IntReg = __m128i;
+    constexpr int laneCount = 4;
+
+    inline FloatReg load(const float* p) noexcept               { return _mm_loadu_ps(p); }
+    inline void store(float* p, FloatReg v) noexcept            { _mm_storeu_ps(p, v); }
+    inline FloatReg broadcast(float v) noexcept                 { return _mm_set1_ps(v); }
+    inline FloatReg add(FloatReg a, FloatReg b) noexcept        { return _mm_add_ps(a, b); }
+    inline FloatReg sub(FloatReg a, FloatReg b) noexcept        { return _mm_sub_ps(a, b); }
+    inline FloatReg mul(FloatReg a, FloatReg b) noexcept        { return _mm_mul_ps(a, b); }
+    inline FloatReg div(FloatReg a, FloatReg b) noexcept        { return _mm_div_ps(a, b); }
+    inline FloatReg min(FloatReg a, FloatReg b) noexcept        { return _mm_min_ps(a, b); }
+    inline FloatReg max(FloatReg a, FloatReg b) noexcept        { return _mm_max_ps(a, b); }
+    inline bool allEqual(FloatReg a, FloatReg b) noexcept       { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)) == 0xf; }
+
+    inline IntReg truncate(FloatReg v) noexcept                 { return _mm_cvttps_epi32(v); }
+    inline FloatReg toFloat(IntReg v) noexcept                  { return _mm_cvtepi32_ps(v); }
+
+    inline IntReg loadInt(const std::uint32_t* p) noexcept      { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    inline void storeInt(std::uint32_t* p, IntReg v) noexcept   { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    inline IntReg broadcastInt(std::uint32_t v) noexcept        { return _mm_set1_epi32((int)v); }
+    inline IntReg addInt(IntReg a, IntReg b) noexcept           { return _mm_add_epi32(a, b); }
+    inline IntReg andInt(IntReg a, IntReg b) noexcept           { return _mm_and_si128(a, b); }
+    template <int bits>
+    inline IntReg shiftRight(IntReg v) noexcept                 { return _mm_srli_epi32(v, bits); }
+
+    inline IntReg octaveAbove(FloatReg v, int maxValue) noexcept
+    {
+        auto e = _mm_srli_epi32(_mm_castps_si128(v), 23);
+        e = _mm_sub_epi32(_mm_and_si128(e, _mm_set1_epi32(0xff)), _mm_set1_epi32(126));
+
+        // SSE2 has no 32-bit integer min/max, so clamp with compare masks.
+        e = _mm_and_si128(e, _mm_cmpgt_epi32(e, _mm_setzero_si128()));
+        const auto hi = _mm_set1_epi32(maxValue);
+        const auto over = _mm_cmpgt_epi32(e, hi);
+        return _mm_or_si128(_mm_and_si128(over, hi), _mm_andnot_si128(over, e));
+    }
+
+    inline FloatReg gather(const float* base, IntReg offsets) noexcept
+    {
+        alignas(16) std::int32_t idx[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx), offsets);
+        return _mm_setr_ps(base[idx[0]], base[idx[1]], base[idx[2]], base[idx[3]]);
+    }
+
+#else
+    constexpr int laneCount = 4;
+    struct FloatReg { float v[laneCount]; };
+    struct IntReg { std::uint32_t v[laneCount]; };
+
+    #define SYNTH_SIMD_LANEWISE(expr) for (int n = 0; n < laneCount; ++n) { expr; }
+
+    inline FloatReg load(const float* p) noexcept               { FloatReg r; SYNTH_SIMD_LANEWISE(r.v[n] = p[n]) return r; }
+    inline void store(float* p, FloatReg a) noexcept            { SYNTH_SIMD_LANEWISE(p[n] = a.v[n]) }
+    inline FloatReg broadcast(float x) noexcept                 { FloatReg r; SYNTH_SIMD_LANEWISE(r.v[n] = x) return r; }
+    inline FloatReg add(FloatReg a, FloatReg b) noexcept        { SYNTH_SIMD_LANEWISE(a.v[n] += b.v[n]) return a; }
+    inline FloatReg sub(FloatReg a, FloatReg b) noexcept        { SYNTH_SIMD_LANEWISE(a.v[n] -= b.v[n]) return a; }
+    inline FloatReg mul(FloatReg a, FloatReg b) noexcept        { SYNTH_SIMD_LANEWISE(a.v[n] *= b.v[n]) return a; }
+    inline FloatReg div(FloatReg a, FloatReg b) noexcept        { SYNTH_SIMD_LANEWISE(a.v[n] /= b.v[n]) return a; }
+    inline FloatReg min(FloatReg a, FloatReg b) noexcept        { SYNTH_SIMD_LANEWISE(a.v[n] = b.v[n] < a.v[n] ? b.v[n] : a.v[n]) return a; }
+    inline FloatReg max(FloatReg a, FloatReg b) noexcept        { SYNTH_SIMD_LANEWISE(a.v[n] = a.v[n] < b.v[n] ? b.v[n] : a.v[n]) return a; }
+    inline bool allEqual(FloatReg a, FloatReg b) noexcept       { bool r = true; SYNTH_SIMD_LANEWISE(r = r && a.v[n] == b.v[n]) return r; }
+    inline IntReg truncate(FloatReg a) noexcept                 { IntReg r; SYNTH_SIMD_LANEWISE(r.v[n] = (std::uint32_t)(std::int32_t)a.v[n]) return r; }
+    inline FloatReg toFloat(IntReg a) noexcept                  { FloatReg r; SYNTH_SIMD_LANEWISE(r.v[n] = (float)(std::int32_t)a.v[n]) return r; }
+
+    inline IntReg loadInt(const std::uint32_t* p) noexcept      { IntReg r; SYNTH_SIMD_LANEWISE(r.v[n] = p[n]) return r; }
+    inline void storeInt(std::uint32_t* p, IntReg a) noexcept   { SYNTH_SIMD_LANEWISE(p[n] = a.v[n]) }
+    inline IntReg broadcastInt(std::uint32_t x) noexcept        { IntReg r; SYNTH_SIMD_LANEWISE(r.v[n] = x) return r; }
+    inline IntReg addInt(IntReg a, IntReg b) noexcept           { SYNTH_SIMD_LANEWISE(a.v[n] += b.v[n]) return a; }
+    inline IntReg andInt(IntReg a, IntReg b) noexcept           { SYNTH_SIMD_LANEWISE(a.v[n] &= b.v[n]) return a; }
+    template <int bits>
+    inline IntReg shiftRight(IntReg a) noexcept                 { SYNTH_SIMD_LANEWISE(a.v[n] >>= bits) return a; }
+
+    inline IntReg octaveAbove(FloatReg a, int maxValue) noexcept
+    {
+        IntReg r;
+        for (int n = 0; n < laneCount; ++n)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &a.v[n], sizeof(bits));
+            r.v[n] = (std::uint32_t)juce::jlimit(0, maxValue, (int)((bits >> 23) & 0xffu) - 126);
+        }
+        return r;
+    }
+
+    inline FloatReg gather(const float* base, IntReg offsets) noexcept
+    {
+        FloatReg r;
+        SYNTH_SIMD_LANEWISE(r.v[n] = base[offsets.v[n]])
+        return r;
+    }
+
+    #undef SYNTH_SIMD_LANEWISE
+#endif
+}
@@ -0,0 +1,63 @@
+#include "SimpleFft.h"
+#include <cmath>
+#include <utility>
+
+SimpleFft::SimpleFft(int order)
+    : size(1 << order)
+{
+    jassert(order > 0 && order < 20);
+
+    twiddles.resize((size_t)size / 2);
+    for (int k = 0; k < size / 2; ++k)
+    {
+        const double angle = -juce::MathConstants<double>::twoPi * (double)k / (double)size;
+        twiddles[(size_t)k] = { (float)std::cos(angle), (float)std::sin(angle) };
+    }
+
+    bitReversed.resize((size_t)size);
+    for (int i = 0; i < size; ++i)
+    {
+        int reversed = 0;
+        for (int b = 0; b < order; ++b)
+            if (i & (1 << b))
+                reversed |= 1 << (order - 1 - b);
+        bitReversed[(size_t)i] = reversed;
+    }
+}
+
+void SimpleFft::perform(std::complex<float>* data, bool inverse) const noexcept
+{
+    for (int i = 0; i < size; ++i)
+    {
+        const int j = bitReversed[(size_t)i];
+        if (j > i)
+            std::swap(data[i], data[j]);
+    }
+
+    for (int span = 1; span < size; span <<= 1)
+    {
+        const int twiddleStride = size / (span * 2);
+
+        for (int start = 0; start < size; start += span * 2)
+        {
+            for (int k = 0; k < span; ++k)
+            {
+                auto w = twiddles[(size_t)(k * twiddleStride)];
+                if (inverse)
+                    w = std::conj(w);
+
+                const auto a = data[start + k];
+                const auto b = data[start + k + span] * w;
+                data[start + k] = a + b;
+                data[start + k + span] = a - b;
+            }
+        }
+    }
+
+    if (inverse)
+    {
+        const float scale = 1.0f / (float)size;
+        for (int i = 0; i < size; ++i)
+            data[i] *= scale;
+    }
+}
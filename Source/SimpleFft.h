@@ -0,0 +1,25 @@
+#pragma once
+#include <JuceHeader.h>
+#include <complex>
+#include <vector>
+
+// Small in-place radix-2 complex FFT. The project doesn't pull in juce_dsp,
+// so this covers the few places that need a spectrum (wavetable band-limiting).
+class SimpleFft
+{
+public:
+    explicit SimpleFft(int order);
+
+    int getSize() const noexcept { return size; }
+
+    // Forward transform is unscaled; the inverse scales by 1/N so a
+    // forward/inverse round trip returns the original signal.
+    void perform(std::complex<float>* data, bool inverse) const noexcept;
+
+private:
+    int size = 0;
+    std::vector<std::complex<float>> twiddles;
+    std::vector<int> bitReversed;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SimpleFft)
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "SimdOps.h"
+
+// A fixed set of linearly smoothed parameters, advanced a block at a time.
+//
+// Same behaviour as juce::SmoothedValue<float, Linear> (a new target restarts
+// a ramp of the configured length from the current value), but instead of one
+// getNextValue() call per parameter per sample, process() writes each
+// parameter's values for the whole block into a contiguous buffer that the
+// DSP reads as an array. Ramps are written with SIMD; a settled parameter's
+// buffer is filled once and then left alone until its value changes.
+template <int NumParams, int MaxBlockSize>
+class SmootherBank
+{
+public:
+    static constexpr int numParams = NumParams;
+    static constexpr int maxBlockSize = MaxBlockSize;
+
+    static_assert(MaxBlockSize % simd::laneCount == 0, "block size must be a multiple of the SIMD width");
+
+    SmootherBank() = default;
+
+    void reset(int param, double sampleRate, double rampLengthSeconds) noexcept
+    {
+        rampSteps[(size_t)param] = (int)std::floor(rampLengthSeconds * sampleRate);
+        setCurrentAndTargetValue(param, target[(size_t)param]);
+    }
+
+    void setCurrentAndTargetValue(int param, float value) noexcept
+    {
+        const auto p = (size_t)param;
+        current[p] = target[p] = value;
+        step[p] = 0.0f;
+        countdown[p] = 0;
+        bufferSettled[p] = false;
+    }
+
+    void setTargetValue(int param, float value) noexcept
+    {
+        const auto p = (size_t)param;
+        if (value == target[p])
+            return;
+
+        if (rampSteps[p] <= 0)
+        {
+            setCurrentAndTargetValue(param, value);
+            return;
+        }
+
+        target[p] = value;
+        countdown[p] = rampSteps[p];
+        step[p] = (target[p] - current[p]) / (float)countdown[p];
+        bufferSettled[p] = false;
+    }
+
+    float getTargetValue(int param) const noexcept   { return target[(size_t)param]; }
+    float getCurrentValue(int param) const noexcept  { return current[(size_t)param]; }
+    bool isSmoothing(int param) const noexcept       { return countdown[(size_t)param] > 0; }
+
+    // Advances every parameter by numSamples and fills its block buffer.
+    void process(int numSamples) noexcept
+    {
+        jassert(numSamples <= MaxBlockSize);
+
+        for (int param = 0; param < NumParams; ++param)
+        {
+            const auto p = (size_t)param;
+            float* out = buffers[p].data();
+
+            if (countdown[p] <= 0)
+            {
+                // Settled: the buffer already holds the value from a previous block
+                if (!bufferSettled[p])
+                {
+                    std::fill(out, out + MaxBlockSize, target[p]);
+                    bufferSettled[p] = true;
+                }
+                continue;
+            }
+
+            const int rampLength = juce::jmin(numSamples, countdown[p]);
+            fillRamp(out, current[p], step[p], rampLength);
+
+            countdown[p] -= rampLength;
+
+            if (countdown[p] > 0)
+            {
+                current[p] += step[p] * (float)rampLength;
+            }
+            else
+            {
+                // Land exactly on the target, like SmoothedValue does. The head
+                // of the buffer still holds the ramp, so the next block refills it.
+                current[p] = target[p];
+                std::fill(out + rampLength, out + MaxBlockSize, target[p]);
+            }
+        }
+    }
+
+    const float* getBuffer(int param) const noexcept { return buffers[(size_t)param].data(); }
+
+    // True when the last process() left every sample of the buffer at the target.
+    bool isBlockConstant(int param) const noexcept   { return bufferSettled[(size_t)param]; }
+
+private:
+    // out[i] = start + stepSize * (i + 1), computed from the start value rather
+    // than accumulated so long ramps don't drift.
+    static void fillRamp(float* out, float start, float stepSize, int numSamples) noexcept
+    {
+        alignas(32) static constexpr float laneOffsets[8] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f };
+        static_assert(simd::laneCount <= 8, "laneOffsets too short");
+
+        const auto startReg = simd::broadcast(start);
+        const auto stepReg = simd::broadcast(stepSize);
+        auto index = simd::load(laneOffsets);
+        const auto indexStep = simd::broadcast((float)simd::laneCount);
+
+        int i = 0;
+        for (; i + simd::laneCount <= numSamples; i += simd::laneCount)
+        {
+            simd::store(out + i, simd::add(startReg, simd::mul(stepReg, index)));
+            index = simd::add(index, indexStep);
+        }
+
+        for (; i < numSamples; ++i)
+            out[i] = start + stepSize * (float)(i + 1);
+    }
+
+    std::array<float, NumParams> current {};
+    std::array<float, NumParams> target {};
+    std::array<float, NumParams> step {};
+    std::array<int, NumParams> countdown {};
+    std::array<int, NumParams> rampSteps {};
+    std::array<bool, NumParams> bufferSettled {};
+
+    alignas(32) std::array<std::array<float, MaxBlockSize>, NumParams> buffers {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SmootherBank)
+};
@@ -0,0 +1,106 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <algorithm>
+#include <vector>
+
+// Lock-free single-producer / single-consumer FIFO of trivially copyable
+// items, for streaming data into or out of the audio thread.
+//
+// The capacity is a power of two and the read / write counters run freely,
+// so the fill level is a plain subtraction and indices wrap with a mask. Each
+// side only stores its own counter, and a push or pop is at most two
+// contiguous copies. A push that doesn't fit is truncated rather than
+// blocking: the producer never waits for the consumer.
+template <typename T>
+class SpscRingBuffer
+{
+public:
+    SpscRingBuffer() = default;
+
+    // Not real-time safe, and neither side may be running.
+    void prepare(int minCapacity)
+    {
+        capacity = juce::nextPowerOfTwo(juce::jmax(2, minCapacity));
+        mask = capacity - 1;
+        items.assign((size_t)capacity, T {});
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        writeCount.store(0, std::memory_order_relaxed);
+        readCount.store(0, std::memory_order_relaxed);
+    }
+
+    int getCapacity() const noexcept { return capacity; }
+
+    // ===== Producer side =====
+    // Returns how many items were queued (less than numItems if full).
+    int push(const T* source, int numItems) noexcept
+    {
+        const auto write = writeCount.load(std::memory_order_relaxed);
+        const auto read = readCount.load(std::memory_order_acquire);
+        const int count = juce::jmin(numItems, capacity - (int)(write - read));
+
+        if (count > 0)
+        {
+            writeSegments(source, (int)(write & (juce::uint32)mask), count);
+            writeCount.store(write + (juce::uint32)count, std::memory_order_release);
+        }
+
+        return juce::jmax(0, count);
+    }
+
+    // ===== Consumer side =====
+    int getNumReady() const noexcept
+    {
+        return (int)(writeCount.load(std::memory_order_acquire) - readCount.load(std::memory_order_relaxed));
+    }
+
+    // Returns how many items were copied into dest.
+    int pop(T* dest, int maxItems) noexcept
+    {
+        const auto read = readCount.load(std::memory_order_relaxed);
+        const auto write = writeCount.load(std::memory_order_acquire);
+        const int count = juce::jmin(maxItems, (int)(write - read));
+
+        if (count > 0)
+        {
+            readSegments(dest, (int)(read & (juce::uint32)mask), count);
+            readCount.store(read + (juce::uint32)count, std::memory_order_release);
+        }
+
+        return juce::jmax(0, count);
+    }
+
+    // Drops everything queued so far.
+    void discardAll() noexcept
+    {
+        readCount.store(writeCount.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    std::vector<T> items;
+    int capacity = 0;
+    int mask = 0;
+
+    alignas(64) std::atomic<juce::uint32> writeCount { 0 };
+    alignas(64) std::atomic<juce::uint32> readCount { 0 };
+
+    void writeSegments(const T* source, int start, int count) noexcept
+    {
+        const int first = juce::jmin(count, capacity - start);
+        std::copy(source, source + first, items.data() + start);
+        std::copy(source + first, source + count, items.data());
+    }
+
+    void readSegments(T* dest, int start, int count) const noexcept
+    {
+        const int first = juce::jmin(count, capacity - start);
+        std::copy(items.data() + start, items.data() + start + first, dest);
+        std::copy(items.data(), items.data() + (count - first), dest + first);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(SpscRingBuffer)
+};
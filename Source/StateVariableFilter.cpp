@@ -0,0 +1,39 @@
+#include "StateVariableFilter.h"
+#include <cmath>
+
+StateVariableFilter::PrewarpTable::PrewarpTable()
+{
+    // Entry i covers fc / fs = i / (2 * tableSize), so the table spans [0, 0.5)
+    for (int i = 0; i < tableSize; ++i)
+        table[(size_t)i] = (float)std::tan(juce::MathConstants<double>::pi * (double)i / (2.0 * tableSize));
+}
+
+StateVariableFilter::ModeMix StateVariableFilter::getModeMix(Mode mode) noexcept
+{
+    ModeMix mix;
+
+    switch (mode)
+    {
+        case bandPass:  mix.input = 0.0f; mix.bandPerK = 1.0f;  mix.low = 0.0f;  break;   // 0 dB peak
+        case highPass:  mix.input = 1.0f; mix.bandPerK = -1.0f; mix.low = -1.0f; break;
+        case notch:     mix.input = 1.0f; mix.bandPerK = -1.0f; mix.low = 0.0f;  break;
+        case lowPass:
+        case numModes:
+        default:        mix.input = 0.0f; mix.bandPerK = 0.0f;  mix.low = 1.0f;  break;
+    }
+
+    return mix;
+}
+
+const char* StateVariableFilter::getModeName(Mode mode) noexcept
+{
+    switch (mode)
+    {
+        case bandPass:  return "BP";
+        case highPass:  return "HP";
+        case notch:     return "Notch";
+        case lowPass:
+        case numModes:
+        default:        return "LP";
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "SimdOps.h"
+
+// Zero-delay-feedback state-variable filter in the topology-preserving
+// transform form (trapezoidal integrators, solved without a unit delay in the
+// loop). Unlike a direct-form biquad, its state is the integrator outputs, so
+// cutoff and Q can change every sample without zipper noise or blow-ups.
+//
+// Everything here works on SIMD registers with one independent filter per
+// lane, so a block of voices is filtered, and has its coefficients rebuilt,
+// in one pass. Q enters as its reciprocal k, which is shared by every lane.
+// Every mode is a fixed mix of the input, band and low outputs, so one
+// processSample() covers them all without branching.
+class StateVariableFilter
+{
+public:
+    enum Mode { lowPass = 0, bandPass, highPass, notch, numModes };
+
+    struct Coefficients
+    {
+        simd::FloatReg a1, a2, a3;
+    };
+
+    // Output = input * input + band * k * bandPerK + low * low
+    struct ModeMix
+    {
+        float input = 0.0f, bandPerK = 0.0f, low = 1.0f;
+    };
+
+    // tan(pi * fc / fs), the bilinear prewarp, read from a table rather than
+    // evaluated per sample. Linear interpolation over 1024 points stays within
+    // 0.001% of std::tan below 0.4 fs (0.06% at the 0.49 fs clamp).
+    class PrewarpTable
+    {
+    public:
+        static constexpr int tableSize = 1024;
+        static constexpr float maxNormalisedCutoff = 0.49f;
+
+        PrewarpTable();
+
+        inline simd::FloatReg lookup(simd::FloatReg normalisedCutoff) const noexcept
+        {
+            const auto clamped = simd::min(simd::max(normalisedCutoff, simd::broadcast(0.0f)),
+                                           simd::broadcast(maxNormalisedCutoff));
+            const auto position = simd::mul(clamped, simd::broadcast(2.0f * (float)tableSize));
+            const auto index = simd::truncate(position);
+            const auto frac = simd::sub(position, simd::toFloat(index));
+            const auto lo = simd::gather(table.data(), index);
+            const auto hi = simd::gather(table.data() + 1, index);
+            return simd::add(lo, simd::mul(frac, simd::sub(hi, lo)));
+        }
+
+    private:
+        std::array<float, tableSize> table {};
+    };
+
+    // q: 0.1..12, same meaning as the RBJ Q.
+    static inline float resonanceToK(float q) noexcept
+    {
+        return 1.0f / juce::jlimit(0.1f, 12.0f, q);
+    }
+
+    // g: prewarped cutoff from PrewarpTable. k: from resonanceToK().
+    static inline Coefficients makeCoefficients(simd::FloatReg g, float k) noexcept
+    {
+        const auto one = simd::broadcast(1.0f);
+
+        Coefficients c;
+        c.a1 = simd::div(one, simd::add(one, simd::mul(g, simd::add(g, simd::broadcast(k)))));
+        c.a2 = simd::mul(g, c.a1);
+        c.a3 = simd::mul(g, c.a2);
+        return c;
+    }
+
+    static ModeMix getModeMix(Mode mode) noexcept;
+    static const char* getModeName(Mode mode) noexcept;
+
+    // ic1 / ic2: the two integrator states of each lane.
+    static inline simd::FloatReg processSample(const Coefficients& c, const ModeMix& mix, float k,
+                                               simd::FloatReg& ic1, simd::FloatReg& ic2,
+                                               simd::FloatReg x) noexcept
+    {
+        const auto two = simd::broadcast(2.0f);
+        const auto v3 = simd::sub(x, ic2);
+        const auto band = simd::add(simd::mul(c.a1, ic1), simd::mul(c.a2, v3));
+        const auto low = simd::add(ic2, simd::add(simd::mul(c.a2, ic1), simd::mul(c.a3, v3)));
+        ic1 = simd::sub(simd::mul(two, band), ic1);
+        ic2 = simd::sub(simd::mul(two, low), ic2);
+
+        return simd::add(simd::mul(simd::broadcast(mix.input), x),
+                         simd::add(simd::mul(simd::broadcast(mix.bandPerK * k), band),
+                                   simd::mul(simd::broadcast(mix.low), low)));
+    }
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+// Lock-free single-producer / single-consumer triple buffer.
+//
+// The producer fills getWriteBuffer() and calls publish(); the consumer calls
+// acquire() and then reads getReadBuffer(), which stays untouched by the
+// producer until the next acquire(). Neither side ever blocks or allocates,
+// so this is safe to use from the audio thread on either end.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // ===== Producer side =====
+    T& getWriteBuffer() noexcept { return buffers[(size_t)backIndex]; }
+
+    void publish() noexcept
+    {
+        backIndex = middle.exchange(backIndex | dirtyFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // ===== Consumer side =====
+    // Returns true if a newer buffer was picked up.
+    bool acquire() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & dirtyFlag) == 0)
+            return false;
+
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& getReadBuffer() const noexcept { return buffers[(size_t)frontIndex]; }
+
+private:
+    static constexpr int dirtyFlag = 4;
+    static constexpr int indexMask = 3;
+
+    std::array<T, 3> buffers {};
+    int backIndex = 0;
+    int frontIndex = 1;
+    std::atomic<int> middle { 2 };
+
+    JUCE_DECLARE_NON_COPYABLE(TripleBuffer)
+};
@@ -0,0 +1,739 @@
+#include "VoiceEngine.h"
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    using Math = dspmath::DefaultPolicy;
+
+    constexpr float oscillatorRatios[VoiceEngine::numOscillatorKinds] = { 1.0f, 0.5f, 1.01f };
+
+    // Spreads unison copies around the cycle so a fresh stack doesn't start as
+    // one phase-coherent spike; fixed so renders stay reproducible.
+    constexpr juce::uint32 unisonPhaseStep = 0x9E3779B9u;
+
+    inline float driveSample(float s, float drive) noexcept
+    {
+        const float preGain = 1.5f + drive * 9.0f;
+        const float softClip = Math::tanh(s * preGain);
+        const float evenHarmonics = Math::tanh((s * preGain) * 0.6f) * 0.8f;
+        const float shaped = juce::jlimit(-1.0f, 1.0f, 0.65f * softClip + 0.35f * evenHarmonics);
+        return juce::jmap(drive, 0.0f, 1.0f, s, shaped);
+    }
+}
+
+VoiceEngine::VoiceEngine()
+{
+    setEnvelope(envParams);
+    setUnison(1, 0.0f, 0.0f);
+}
+
+void VoiceEngine::prepare(double newSampleRate, int newNumVoices)
+{
+    sampleRate = newSampleRate;
+    invSampleRate = (float)(1.0 / sampleRate);
+    numBlocks = (juce::jlimit(1, maxVoices, newNumVoices) + voicesPerBlock - 1) / voicesPerBlock;
+    numVoices = numBlocks * voicesPerBlock;
+
+    const auto n = (size_t)numVoices;
+    voiceNote.assign(n, -1);
+    voiceVelocity.assign(n, 0.0f);
+    voiceStartOrder.assign(n, 0);
+    freqCurrent.assign(n, 220.0f);
+    freqTarget.assign(n, 220.0f);
+    freqStep.assign(n, 0.0f);
+    glideRemaining.assign(n, 0);
+    envStage.assign(n, envIdle);
+    envLevel.assign(n, 0.0f);
+    envReleaseRate.assign(n, 0.0f);
+
+    for (auto* state : { &filterA1, &filterA2, &filterA3, &filterIc1, &filterIc2, &filterIc1R, &filterIc2R })
+        state->assign(n, 0.0f);
+    filterCutoff.assign(n, -1.0f);
+    filterK.assign((size_t)numBlocks, 0.0f);
+    filterSplit.assign((size_t)numBlocks, 0);
+    driveOversampleState.assign(n * 2, Oversampler::ChannelState());
+
+    kernels = std::make_unique<OscillatorKernel[]>((size_t)(numBlocks * numOscillatorKinds));
+    unisonKernels = std::make_unique<OscillatorKernel[]>((size_t)(numVoices * unisonKernelsPerVoice));
+    oscScratch.assign((size_t)(numBlocks * scratchPerBlock), 0.0f);
+    blockMix.assign((size_t)(numBlocks * 2 * maxChunkSize), 0.0f);
+
+    blockOversamplers = std::make_unique<Oversampler[]>((size_t)numBlocks);
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        blockOversamplers[(size_t)b].prepare(maxChunkSize);
+        blockOversamplers[(size_t)b].setFactorLog2(oversamplingLog2);
+    }
+    activeBlocks.assign((size_t)numBlocks, 0);
+    numActiveBlocks = 0;
+
+    setEnvelope(envParams);
+    reset();
+}
+
+void VoiceEngine::reset() noexcept
+{
+    for (int v = 0; v < numVoices; ++v)
+    {
+        voiceNote[(size_t)v] = -1;
+        envStage[(size_t)v] = envIdle;
+        envLevel[(size_t)v] = 0.0f;
+        filterIc1[(size_t)v] = filterIc2[(size_t)v] = 0.0f;
+        filterIc1R[(size_t)v] = filterIc2R[(size_t)v] = 0.0f;
+        filterCutoff[(size_t)v] = -1.0f;
+    }
+
+    for (int k = 0; k < numBlocks * numOscillatorKinds; ++k)
+        kernels[(size_t)k].resetPhases();
+
+    for (int k = 0; k < numVoices * unisonKernelsPerVoice; ++k)
+        unisonKernels[(size_t)k].resetPhases();
+
+    for (auto& state : driveOversampleState)
+        state.reset();
+
+    newestVoice = -1;
+}
+
+void VoiceEngine::setEnvelope(const juce::ADSR::Parameters& params) noexcept
+{
+    envParams = params;
+
+    auto rate = [this](float distance, float seconds)
+    {
+        return seconds > 0.0f ? (float)(distance / (seconds * sampleRate)) : -1.0f;
+    };
+
+    attackRate = rate(1.0f, envParams.attack);
+    decayRate = rate(1.0f - envParams.sustain, envParams.decay);
+}
+
+void VoiceEngine::setUnison(int count, float spread, float stereo) noexcept
+{
+    count = juce::jlimit(1, maxUnison, count);
+    spread = juce::jlimit(0.0f, 1.0f, spread);
+    stereo = juce::jlimit(0.0f, 1.0f, stereo);
+
+    if (count == unisonCount && spread == unisonSpread && stereo == unisonStereo)
+        return;
+
+    unisonCount = count;
+    unisonSpread = spread;
+    unisonStereo = stereo;
+    unisonIsStereo = count > 1 && stereo > 0.0f;
+
+    unisonRatios.fill(0.0f);
+    unisonGainL.fill(0.0f);
+    unisonGainR.fill(0.0f);
+
+    if (count == 1)
+        return;
+
+    // Copies sit evenly between -spread and +spread, outer copies panned
+    // furthest; the stack is normalised so its level matches one oscillator.
+    const float norm = 1.0f / std::sqrt((float)count);
+
+    for (int u = 0; u < count; ++u)
+    {
+        const float position = 2.0f * (float)u / (float)(count - 1) - 1.0f;
+        const float cents = position * spread * maxUnisonSpreadCents;
+        const float pan = position * stereo;
+
+        unisonRatios[(size_t)u] = std::exp2(cents / 1200.0f);
+        unisonGainL[(size_t)u] = norm * std::sqrt(1.0f - pan);
+        unisonGainR[(size_t)u] = norm * std::sqrt(1.0f + pan);
+    }
+}
+
+void VoiceEngine::setOversampling(int factorLog2) noexcept
+{
+    factorLog2 = juce::jlimit(0, Oversampler::maxFactorLog2, factorLog2);
+    if (factorLog2 == oversamplingLog2)
+        return;
+
+    oversamplingLog2 = factorLog2;
+
+    for (int b = 0; b < numBlocks; ++b)
+        blockOversamplers[(size_t)b].setFactorLog2(factorLog2);
+
+    for (auto& state : driveOversampleState)
+        state.reset();
+}
+
+//==============================================================================
+float VoiceEngine::midiNoteToFreq(int midiNote) noexcept
+{
+    return 440.0f * std::pow(2.0f, (float)(midiNote - 69) / 12.0f);
+}
+
+void VoiceEngine::startVoice(int voice, int midiNote, float velocity) noexcept
+{
+    const auto v = (size_t)voice;
+    voiceNote[v] = midiNote;
+    voiceVelocity[v] = juce::jlimit(0.0f, 1.0f, velocity);
+    voiceStartOrder[v] = ++noteCounter;
+
+    freqCurrent[v] = freqTarget[v] = juce::jlimit(20.0f, 20000.0f, midiNoteToFreq(midiNote));
+    glideRemaining[v] = 0;
+    filterCutoff[v] = -1.0f;
+
+    for (int k = 0; k < unisonKernelsPerVoice; ++k)
+        for (int lane = 0; lane < voicesPerBlock; ++lane)
+            unisonKernels[(size_t)(voice * unisonKernelsPerVoice + k)]
+                .setLanePhase(lane, (juce::uint32)(k * voicesPerBlock + lane) * unisonPhaseStep);
+
+    // Like juce::ADSR, the attack continues from the current level, so a
+    // stolen or retriggered voice doesn't click.
+    if (attackRate > 0.0f)
+    {
+        envStage[v] = envAttack;
+    }
+    else if (decayRate > 0.0f)
+    {
+        envLevel[v] = 1.0f;
+        envStage[v] = envDecay;
+    }
+    else
+    {
+        envLevel[v] = envParams.sustain;
+        envStage[v] = envSustain;
+    }
+
+    newestVoice = voice;
+}
+
+void VoiceEngine::releaseVoice(int voice) noexcept
+{
+    const auto v = (size_t)voice;
+    if (envStage[v] == envIdle || envStage[v] == envRelease)
+        return;
+
+    if (envParams.release > 0.0f)
+    {
+        envReleaseRate[v] = (float)(envLevel[v] / (envParams.release * sampleRate));
+        envStage[v] = envRelease;
+    }
+    else
+    {
+        envLevel[v] = 0.0f;
+        envStage[v] = envIdle;
+        voiceNote[v] = -1;
+    }
+}
+
+int VoiceEngine::findVoiceToSteal() const noexcept
+{
+    // Prefer the quietest voice that is already releasing, then the oldest one.
+    int quietest = -1;
+    int oldest = 0;
+
+    for (int v = 0; v < numVoices; ++v)
+    {
+        const auto i = (size_t)v;
+        if (envStage[i] == envRelease && (quietest < 0 || envLevel[i] < envLevel[(size_t)quietest]))
+            quietest = v;
+
+        if (voiceStartOrder[i] < voiceStartOrder[(size_t)oldest])
+            oldest = v;
+    }
+
+    return quietest >= 0 ? quietest : oldest;
+}
+
+void VoiceEngine::noteOn(int midiNote, float velocity) noexcept
+{
+    if (numVoices == 0)
+        return;
+
+    int target = -1;
+    int idle = -1;
+
+    for (int v = 0; v < numVoices; ++v)
+    {
+        if (voiceNote[(size_t)v] == midiNote && envStage[(size_t)v] != envIdle)
+        {
+            target = v;
+            break;
+        }
+
+        if (idle < 0 && envStage[(size_t)v] == envIdle)
+            idle = v;
+    }
+
+    if (target < 0)
+        target = idle >= 0 ? idle : findVoiceToSteal();
+
+    startVoice(target, midiNote, velocity);
+}
+
+void VoiceEngine::noteOff(int midiNote) noexcept
+{
+    for (int v = 0; v < numVoices; ++v)
+        if (voiceNote[(size_t)v] == midiNote)
+            releaseVoice(v);
+}
+
+void VoiceEngine::releaseAll() noexcept
+{
+    for (int v = 0; v < numVoices; ++v)
+        releaseVoice(v);
+}
+
+void VoiceEngine::retuneNewestVoice(float frequency) noexcept
+{
+    if (newestVoice < 0 || envStage[(size_t)newestVoice] == envIdle)
+        return;
+
+    const auto v = (size_t)newestVoice;
+    const int glideSamples = juce::jmax(1, (int)std::round(glideSeconds * sampleRate));
+    freqTarget[v] = juce::jlimit(20.0f, 20000.0f, frequency);
+    freqStep[v] = (freqTarget[v] - freqCurrent[v]) / (float)glideSamples;
+    glideRemaining[v] = glideSamples;
+}
+
+int VoiceEngine::getNumActiveVoices() const noexcept
+{
+    int count = 0;
+    for (int v = 0; v < numVoices; ++v)
+        if (envStage[(size_t)v] != envIdle)
+            ++count;
+    return count;
+}
+
+//==============================================================================
+bool VoiceEngine::isBlockActive(int block) const noexcept
+{
+    for (int w = 0; w < voicesPerBlock; ++w)
+        if (envStage[(size_t)(block * voicesPerBlock + w)] != envIdle)
+            return true;
+    return false;
+}
+
+void VoiceEngine::advanceGlide(int voice, int numSamples) noexcept
+{
+    const auto v = (size_t)voice;
+    if (glideRemaining[v] <= 0)
+        return;
+
+    const int steps = juce::jmin(numSamples, glideRemaining[v]);
+    glideRemaining[v] -= steps;
+    freqCurrent[v] = glideRemaining[v] > 0 ? freqCurrent[v] + freqStep[v] * (float)steps : freqTarget[v];
+}
+
+void VoiceEngine::updateKernelRatios(int block) noexcept
+{
+    for (int kind = 0; kind < numOscillatorKinds; ++kind)
+    {
+        auto& kernel = kernels[(size_t)(block * numOscillatorKinds + kind)];
+        for (int w = 0; w < voicesPerBlock; ++w)
+            kernel.setLaneRatio(w, freqCurrent[(size_t)(block * voicesPerBlock + w)] * invSampleRate * oscillatorRatios[kind]);
+    }
+
+    if (unisonCount == 1)
+        return;
+
+    const int kernelsInUse = (unisonCount + voicesPerBlock - 1) / voicesPerBlock;
+
+    for (int w = 0; w < voicesPerBlock; ++w)
+    {
+        const int voice = block * voicesPerBlock + w;
+        const float baseRatio = freqCurrent[(size_t)voice] * invSampleRate;
+
+        for (int k = 0; k < kernelsInUse; ++k)
+        {
+            auto& kernel = unisonKernels[(size_t)(voice * unisonKernelsPerVoice + k)];
+            for (int lane = 0; lane < voicesPerBlock; ++lane)
+                kernel.setLaneRatio(lane, baseRatio * unisonRatios[(size_t)(k * voicesPerBlock + lane)]);
+        }
+    }
+}
+
+void VoiceEngine::renderUnison(int voice, const WavetableOscillator::TableSet& tables, const float* pitchMod,
+                               int numSamples, float* kernelOutput, float* sumL, float* sumR) noexcept
+{
+    const int kernelsInUse = (unisonCount + voicesPerBlock - 1) / voicesPerBlock;
+
+    juce::FloatVectorOperations::clear(sumL, numSamples);
+    juce::FloatVectorOperations::clear(sumR, numSamples);
+
+    for (int k = 0; k < kernelsInUse; ++k)
+    {
+        unisonKernels[(size_t)(voice * unisonKernelsPerVoice + k)].render(tables, pitchMod, numSamples, kernelOutput);
+
+        // Unused lanes carry zero gain, so the whole vector is summed
+        const float* gainL = unisonGainL.data() + k * voicesPerBlock;
+        const float* gainR = unisonGainR.data() + k * voicesPerBlock;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float* copies = kernelOutput + (size_t)i * voicesPerBlock;
+            float l = 0.0f, r = 0.0f;
+            for (int lane = 0; lane < voicesPerBlock; ++lane)
+            {
+                l += copies[lane] * gainL[lane];
+                r += copies[lane] * gainR[lane];
+            }
+            sumL[i] += l;
+            sumR[i] += r;
+        }
+    }
+}
+
+inline float VoiceEngine::nextEnvelopeSample(int voice) noexcept
+{
+    const auto v = (size_t)voice;
+    float level = envLevel[v];
+
+    switch (envStage[v])
+    {
+        case envAttack:
+            level += attackRate;
+            if (level >= 1.0f)
+            {
+                level = 1.0f;
+                envStage[v] = decayRate > 0.0f ? envDecay : envSustain;
+            }
+            break;
+
+        case envDecay:
+            level -= decayRate;
+            if (level <= envParams.sustain)
+            {
+                level = envParams.sustain;
+                envStage[v] = envSustain;
+            }
+            break;
+
+        case envSustain:
+            level = envParams.sustain;
+            break;
+
+        case envRelease:
+            level -= envReleaseRate[v];
+            if (level <= 0.0f)
+            {
+                level = 0.0f;
+                envStage[v] = envIdle;
+                voiceNote[v] = -1;
+            }
+            break;
+
+        case envIdle:
+        default:
+            level = 0.0f;
+            break;
+    }
+
+    envLevel[v] = level;
+    return level;
+}
+
+bool VoiceEngine::filterStatesConverged(simd::FloatReg ic1, simd::FloatReg ic2,
+                                        simd::FloatReg ic1R, simd::FloatReg ic2R) noexcept
+{
+    // Fed the same input, the two sides' difference decays at the filter's
+    // own rate; once it's far below audibility the right side can snap over.
+    constexpr float tolerance = 1.0e-6f;
+
+    alignas(32) float left[2 * voicesPerBlock];
+    alignas(32) float right[2 * voicesPerBlock];
+    simd::store(left, ic1);
+    simd::store(left + voicesPerBlock, ic2);
+    simd::store(right, ic1R);
+    simd::store(right + voicesPerBlock, ic2R);
+
+    for (int n = 0; n < 2 * voicesPerBlock; ++n)
+        if (std::abs(left[n] - right[n]) > tolerance)
+            return false;
+
+    return true;
+}
+
+//==============================================================================
+void VoiceEngine::render(const WavetableOscillator::TableSet& tables, const ChunkControls& controls,
+                         int numSamples, float* mixL, float* mixR, RealtimeThreadPool* pool) noexcept
+{
+    jassert(numSamples <= maxChunkSize);
+
+    if (controls.filterMode != filterMode)
+    {
+        filterMode = controls.filterMode;
+        std::fill(filterCutoff.begin(), filterCutoff.end(), -1.0f);
+    }
+
+    numActiveBlocks = 0;
+    for (int block = 0; block < numBlocks; ++block)
+        if (isBlockActive(block))
+            activeBlocks[(size_t)numActiveBlocks++] = block;
+
+    pendingTables = &tables;
+    pendingControls = &controls;
+    pendingNumSamples = numSamples;
+
+    if (pool != nullptr)
+        pool->run(*this, numActiveBlocks);
+    else
+        for (int t = 0; t < numActiveBlocks; ++t)
+            runTask(t);
+
+    // Deterministic mixdown: always summed in block order
+    juce::FloatVectorOperations::clear(mixL, numSamples);
+    juce::FloatVectorOperations::clear(mixR, numSamples);
+    for (int t = 0; t < numActiveBlocks; ++t)
+    {
+        const float* blockOut = blockMix.data() + (size_t)(activeBlocks[(size_t)t] * 2 * maxChunkSize);
+        juce::FloatVectorOperations::add(mixL, blockOut, numSamples);
+        juce::FloatVectorOperations::add(mixR, blockOut + maxChunkSize, numSamples);
+    }
+}
+
+void VoiceEngine::runTask(int taskIndex) noexcept
+{
+    renderBlock(activeBlocks[(size_t)taskIndex], *pendingTables, *pendingControls, pendingNumSamples);
+}
+
+void VoiceEngine::applyDrive(int block, Oversampler::ChannelState& state, float* signal,
+                              const float* drive, int numSamples, float* oversampled) noexcept
+{
+    auto& oversampler = blockOversamplers[(size_t)block];
+    const int factor = oversampler.getFactor();
+
+    if (factor == 1)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            if (drive[i] > 0.0f)
+                signal[i] = driveSample(signal[i], drive[i]);
+        return;
+    }
+
+    // Always round-trips through the oversampler, even at zero drive, so the
+    // latency never changes under the player's hands.
+    oversampler.upsample(state, signal, oversampled, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float d = drive[i];
+        if (d <= 0.0f)
+            continue;
+
+        float* frame = oversampled + (size_t)i * (size_t)factor;
+        for (int k = 0; k < factor; ++k)
+            frame[k] = driveSample(frame[k], d);
+    }
+
+    oversampler.downsample(state, oversampled, signal, numSamples);
+}
+
+void VoiceEngine::renderBlock(int block, const WavetableOscillator::TableSet& tables,
+                              const ChunkControls& controls, int numSamples) noexcept
+{
+    const int firstVoice = block * voicesPerBlock;
+    constexpr size_t laneScratch = (size_t)(maxChunkSize * voicesPerBlock);
+
+    float* scratch = oscScratch.data() + (size_t)(block * scratchPerBlock);
+    float* oscOutput[numOscillatorKinds];
+    for (int kind = 0; kind < numOscillatorKinds; ++kind)
+        oscOutput[kind] = scratch + (size_t)kind * laneScratch;
+    float* voiceL = scratch + (size_t)numOscillatorKinds * laneScratch;
+    float* voiceR = voiceL + laneScratch;
+    float* oversampled = voiceR + laneScratch;
+
+    float* mixL = blockMix.data() + (size_t)(block * 2 * maxChunkSize);
+    float* mixR = mixL + maxChunkSize;
+
+    for (int w = 0; w < voicesPerBlock; ++w)
+        advanceGlide(firstVoice + w, numSamples);
+
+    updateKernelRatios(block);
+
+    const bool unison = unisonCount > 1;
+    const bool stereo = unisonIsStereo;
+
+    // With unison on, the primary lane of the block kernel is replaced by each
+    // voice's stack (summed into voiceL/voiceR), and the primary scratch is
+    // reused for the unison kernel output.
+    for (int kind = unison ? subOsc : primaryOsc; kind < numOscillatorKinds; ++kind)
+        kernels[(size_t)(block * numOscillatorKinds + kind)].render(tables, controls.pitchMod, numSamples, oscOutput[kind]);
+
+    if (unison)
+        for (int w = 0; w < voicesPerBlock; ++w)
+            if (envStage[(size_t)(firstVoice + w)] != envIdle)
+                renderUnison(firstVoice + w, tables, controls.pitchMod, numSamples, oscOutput[primaryOsc],
+                             voiceL + w * maxChunkSize, voiceR + w * maxChunkSize);
+
+    const float subMix = juce::jlimit(0.0f, 1.0f, controls.subMix);
+    const float envFilterAmt = juce::jlimit(-1.0f, 1.0f, controls.envFilterAmount);
+
+    // ===== Oscillator mix, gain and velocity into each voice's signal =====
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float* primary = oscOutput[primaryOsc] + (size_t)i * voicesPerBlock;
+        const float* sub = oscOutput[subOsc] + (size_t)i * voicesPerBlock;
+        const float* detune = oscOutput[detuneOsc] + (size_t)i * voicesPerBlock;
+        const float gain = controls.gain[i];
+
+        auto mixOscillators = [&](float osc, int w)
+        {
+            const float stacked = juce::jlimit(-1.0f, 1.0f,
+                osc * 0.55f + sub[w] * 0.35f + detune[w] * 0.35f);
+            return juce::jmap(subMix, osc, stacked) * gain * voiceVelocity[(size_t)(firstVoice + w)];
+        };
+
+        for (int w = 0; w < voicesPerBlock; ++w)
+        {
+            if (envStage[(size_t)(firstVoice + w)] == envIdle)
+                continue;
+
+            const size_t index = (size_t)(w * maxChunkSize + i);
+            voiceL[index] = mixOscillators(unison ? voiceL[index] : primary[w], w);
+
+            if (stereo)
+                voiceR[index] = mixOscillators(voiceR[index], w);
+        }
+    }
+
+    // ===== Drive, oversampled when enabled =====
+    for (int w = 0; w < voicesPerBlock; ++w)
+    {
+        const auto v = (size_t)(firstVoice + w);
+        if (envStage[v] == envIdle)
+            continue;
+
+        applyDrive(block, driveOversampleState[v * 2], voiceL + w * maxChunkSize,
+                   controls.drive, numSamples, oversampled);
+
+        if (stereo)
+            applyDrive(block, driveOversampleState[v * 2 + 1], voiceR + w * maxChunkSize,
+                       controls.drive, numSamples, oversampled);
+        else if (oversamplingLog2 > 0)
+            driveOversampleState[v * 2 + 1] = driveOversampleState[v * 2];
+    }
+
+    // ===== Envelopes, and the filter input transposed to one lane per voice =====
+    // The oscillator scratch is free again once the voices are mixed.
+    float* envelopes = oscOutput[primaryOsc];
+    float* laneInL = oscOutput[subOsc];
+    float* laneInR = oscOutput[detuneOsc];
+
+    for (int w = 0; w < voicesPerBlock; ++w)
+    {
+        const int voice = firstVoice + w;
+        const bool active = envStage[(size_t)voice] != envIdle;
+        const float* inL = voiceL + w * maxChunkSize;
+        const float* inR = voiceR + w * maxChunkSize;
+
+        // A finished voice's envelope stays at 0 and its lane is fed silence,
+        // so idle filters settle instead of chewing on stale scratch.
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float env = active ? nextEnvelopeSample(voice) : 0.0f;
+            const size_t lane = (size_t)(i * voicesPerBlock + w);
+            envelopes[lane] = env;
+            laneInL[lane] = env > 0.0f ? inL[i] : 0.0f;
+        }
+
+        if (stereo)
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const size_t lane = (size_t)(i * voicesPerBlock + w);
+                laneInR[lane] = envelopes[lane] > 0.0f ? inR[i] : 0.0f;
+            }
+    }
+
+    // The right filters only run while the block is stereo, or while they
+    // are still catching up with the left ones after it went mono. With
+    // identical input and state both sides would compute the same thing.
+    const bool filterStereo = stereo || filterSplit[(size_t)block] != 0;
+    const float* rightInput = stereo ? laneInR : laneInL;
+
+    // ===== Filter, all voices of the block at once =====
+    const auto mode = StateVariableFilter::getModeMix(filterMode);
+    const auto invRate = simd::broadcast(invSampleRate);
+    const auto envAmount = simd::broadcast(envFilterAmt);
+    const auto one = simd::broadcast(1.0f);
+
+    StateVariableFilter::Coefficients coeffs { simd::load(filterA1.data() + firstVoice),
+                                               simd::load(filterA2.data() + firstVoice),
+                                               simd::load(filterA3.data() + firstVoice) };
+    auto lastCutoff = simd::load(filterCutoff.data() + firstVoice);
+    float lastK = filterK[(size_t)block];
+
+    auto ic1 = simd::load(filterIc1.data() + firstVoice);
+    auto ic2 = simd::load(filterIc2.data() + firstVoice);
+    auto ic1R = simd::load(filterIc1R.data() + firstVoice);
+    auto ic2R = simd::load(filterIc2R.data() + firstVoice);
+
+    alignas(32) float laneOut[voicesPerBlock];
+
+    // Voices are summed in lane order, as they were when each was filtered alone
+    auto sumLanes = [&laneOut](simd::FloatReg v)
+    {
+        simd::store(laneOut, v);
+        float sum = 0.0f;
+        for (int w = 0; w < voicesPerBlock; ++w)
+            sum += laneOut[w];
+        return sum;
+    };
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float modFactor = Math::exp2(controls.lfoCutModAmount * controls.lfo[i]);
+        const float k = StateVariableFilter::resonanceToK(controls.resonance[i]);
+        const auto env = simd::load(envelopes + i * voicesPerBlock);
+
+        // Per-sample cutoff; a sustained note with a static knob and no LFO
+        // lands on the same value and skips the rebuild.
+        const auto envFactor = simd::min(simd::max(simd::add(one, simd::mul(envAmount, env)), simd::broadcast(0.1f)),
+                                         simd::broadcast(4.0f));
+        const auto effCut = simd::min(simd::max(simd::mul(simd::broadcast(controls.cutoff[i] * modFactor), envFactor),
+                                                simd::broadcast(80.0f)),
+                                      simd::broadcast(14000.0f));
+
+        if (k != lastK || !simd::allEqual(effCut, lastCutoff))
+        {
+            coeffs = StateVariableFilter::makeCoefficients(prewarp.lookup(simd::mul(effCut, invRate)), k);
+            lastCutoff = effCut;
+            lastK = k;
+        }
+
+        const auto filtered = StateVariableFilter::processSample(coeffs, mode, k, ic1, ic2,
+                                                                 simd::load(laneInL + i * voicesPerBlock));
+        mixL[i] = sumLanes(simd::mul(filtered, env));
+
+        if (filterStereo)
+        {
+            const auto filteredR = StateVariableFilter::processSample(coeffs, mode, k, ic1R, ic2R,
+                                                                      simd::load(rightInput + i * voicesPerBlock));
+            mixR[i] = sumLanes(simd::mul(filteredR, env));
+        }
+        else
+        {
+            mixR[i] = mixL[i];
+        }
+    }
+
+    if (stereo)
+    {
+        filterSplit[(size_t)block] = 1;
+    }
+    else if (!filterStereo || filterStatesConverged(ic1, ic2, ic1R, ic2R))
+    {
+        // Mono: keep the right state tracking so panning in later doesn't click
+        filterSplit[(size_t)block] = 0;
+        ic1R = ic1;
+        ic2R = ic2;
+    }
+
+    simd::store(filterA1.data() + firstVoice, coeffs.a1);
+    simd::store(filterA2.data() + firstVoice, coeffs.a2);
+    simd::store(filterA3.data() + firstVoice, coeffs.a3);
+    simd::store(filterCutoff.data() + firstVoice, lastCutoff);
+    filterK[(size_t)block] = lastK;
+
+    simd::store(filterIc1.data() + firstVoice, ic1);
+    simd::store(filterIc2.data() + firstVoice, ic2);
+    simd::store(filterIc1R.data() + firstVoice, ic1R);
+    simd::store(filterIc2R.data() + firstVoice, ic2R);
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <memory>
+#include <vector>
+#include "OscillatorKernel.h"
+#include "RealtimeThreadPool.h"
+#include "Oversampler.h"
+#include "StateVariableFilter.h"
+#include "WavetableOscillator.h"
+
+// Fixed-size polyphonic voice pool.
+//
+// Voice state is stored structure-of-arrays and voices are grouped into
+// blocks of simd::laneCount, so one OscillatorKernel pass renders the same
+// oscillator for a whole block of voices and the per-voice mix / drive /
+// filter / envelope loops run over contiguous lanes. Everything is sized in
+// prepare(); note on/off never allocates.
+//
+// Unison: with more than one copy, each voice's primary oscillator becomes a
+// stack of detuned copies. Those copies are the lanes of the voice's own
+// unison kernels, so an 8-copy stack costs one kernel pass at 8 lanes. With a
+// single copy nothing changes and the primary stays a lane of the block kernel.
+//
+// Drive is the only nonlinear stage in a voice; with oversampling enabled it
+// runs at 2x/4x/8x between a per-voice up- and downsampler, and everything
+// linear (mixing, filter, envelope) stays at the device rate.
+//
+// The filter is a per-voice state-variable filter whose cutoff follows the
+// LFO and envelope every sample. It runs one voice per SIMD lane, and a
+// block's coefficients are only rebuilt when some voice's effective cutoff
+// or the Q actually moves.
+//
+// Voice blocks are independent of each other, so render() can hand them to a
+// RealtimeThreadPool. Each block writes into its own scratch and mix buffer
+// and the blocks are summed in index order afterwards, so the output is the
+// same bit for bit whichever thread rendered which block.
+class VoiceEngine : private RealtimeThreadPool::Job
+{
+public:
+    static constexpr int maxVoices = 64;
+    static constexpr int defaultVoices = 32;
+    static constexpr int voicesPerBlock = OscillatorKernel::laneCount;
+    static constexpr int maxChunkSize = 256;
+    static constexpr int maxUnison = 16;
+    static constexpr int unisonKernelsPerVoice = (maxUnison + voicesPerBlock - 1) / voicesPerBlock;
+
+    enum OscillatorKind { primaryOsc = 0, subOsc, detuneOsc, numOscillatorKinds };
+
+    // Per-sample modulation shared by every voice for one chunk.
+    struct ChunkControls
+    {
+        const float* pitchMod = nullptr;    // vibrato * chaos, multiplies every voice's increment
+        const float* lfo = nullptr;         // raw LFO value, drives the filter mod
+        const float* gain = nullptr;
+        const float* cutoff = nullptr;
+        const float* resonance = nullptr;
+        const float* drive = nullptr;
+        float subMix = 0.0f;
+        float envFilterAmount = 0.0f;
+        float lfoCutModAmount = 0.0f;
+        StateVariableFilter::Mode filterMode = StateVariableFilter::lowPass;
+    };
+
+    VoiceEngine();
+
+    // Not real-time safe: sizes the voice pool.
+    void prepare(double sampleRate, int numVoices);
+    void reset() noexcept;
+
+    void setEnvelope(const juce::ADSR::Parameters& params) noexcept;
+
+    // count: copies per voice (1..maxUnison). spread: 0..1 of the maximum
+    // detune. stereo: 0..1, how far the outer copies are panned.
+    void setUnison(int count, float spread, float stereo) noexcept;
+
+    // 0 = off, 1/2/3 = 2x/4x/8x around the drive stage. Real-time safe.
+    void setOversampling(int factorLog2) noexcept;
+    float getLatencySamples() const noexcept { return Oversampler::getLatencySamples(oversamplingLog2); }
+
+    void noteOn(int midiNote, float velocity) noexcept;
+    void noteOff(int midiNote) noexcept;
+    void releaseAll() noexcept;
+
+    // Glides the most recently started voice to a new pitch.
+    void retuneNewestVoice(float frequency) noexcept;
+
+    int getNumVoices() const noexcept { return numVoices; }
+    int getNumBlocks() const noexcept { return numBlocks; }
+    int getNumActiveVoices() const noexcept;
+
+    // Renders all active voices and writes their stereo sum into mixL/mixR.
+    // With a pool, voice blocks are spread over its workers and the calling thread.
+    void render(const WavetableOscillator::TableSet& tables, const ChunkControls& controls,
+                int numSamples, float* mixL, float* mixR, RealtimeThreadPool* pool = nullptr) noexcept;
+
+private:
+    enum EnvelopeStage : juce::uint8 { envIdle = 0, envAttack, envDecay, envSustain, envRelease };
+
+    static constexpr float glideSeconds = 0.02f;
+    static constexpr float maxUnisonSpreadCents = 50.0f;
+
+    double sampleRate = 44100.0;
+    float invSampleRate = 1.0f / 44100.0f;
+    int numVoices = 0;
+    int numBlocks = 0;
+    juce::uint32 noteCounter = 0;
+    int newestVoice = -1;
+    StateVariableFilter::Mode filterMode = StateVariableFilter::lowPass;
+    StateVariableFilter::PrewarpTable prewarp;
+
+    // Shared envelope rates (juce::ADSR semantics)
+    juce::ADSR::Parameters envParams;
+    float attackRate = 0.0f;
+    float decayRate = 0.0f;
+
+    // Unison copy layout, shared by every voice
+    int unisonCount = 1;
+    float unisonSpread = -1.0f;
+    float unisonStereo = -1.0f;
+    bool unisonIsStereo = false;
+    std::array<float, unisonKernelsPerVoice * voicesPerBlock> unisonRatios {};
+    std::array<float, unisonKernelsPerVoice * voicesPerBlock> unisonGainL {};
+    std::array<float, unisonKernelsPerVoice * voicesPerBlock> unisonGainR {};
+
+    int oversamplingLog2 = 0;
+
+    // ===== Per-voice state (structure of arrays) =====
+    std::vector<int> voiceNote;
+    std::vector<float> voiceVelocity;
+    std::vector<juce::uint32> voiceStartOrder;
+
+    std::vector<float> freqCurrent;
+    std::vector<float> freqTarget;
+    std::vector<float> freqStep;
+    std::vector<int> glideRemaining;
+
+    std::vector<juce::uint8> envStage;
+    std::vector<float> envLevel;
+    std::vector<float> envReleaseRate;
+
+    // State-variable filter per voice, with a second state for the right
+    // channel once unison is panned. filterCutoff (per voice) and filterK (per
+    // block) are what the coefficients were built for; a negative cutoff
+    // forces a rebuild. filterSplit marks blocks whose right state has
+    // diverged from the left and still needs its own pass.
+    std::vector<float> filterA1, filterA2, filterA3;
+    std::vector<float> filterIc1, filterIc2, filterIc1R, filterIc2R;
+    std::vector<float> filterCutoff, filterK;
+    std::vector<juce::uint8> filterSplit;
+
+    // Drive oversampler state, left and right per voice
+    std::vector<Oversampler::ChannelState> driveOversampleState;
+
+    // One kernel per (voice block, oscillator kind), plus the unison copies of each voice
+    std::unique_ptr<OscillatorKernel[]> kernels;
+    std::unique_ptr<OscillatorKernel[]> unisonKernels;
+
+    // Per-block scratch (three oscillator kinds, left/right per-voice signal,
+    // oversampled drive buffer), stereo mix and oversampler, so blocks can
+    // render in parallel
+    static constexpr int scratchPerBlock = (numOscillatorKinds + 2) * maxChunkSize * voicesPerBlock
+                                         + maxChunkSize * Oversampler::maxFactor;
+    std::vector<float> oscScratch;
+    std::vector<float> blockMix;
+    std::unique_ptr<Oversampler[]> blockOversamplers;
+
+    // Set up by render() for the duration of one dispatch
+    std::vector<int> activeBlocks;
+    int numActiveBlocks = 0;
+    const WavetableOscillator::TableSet* pendingTables = nullptr;
+    const ChunkControls* pendingControls = nullptr;
+    int pendingNumSamples = 0;
+
+    void startVoice(int voice, int midiNote, float velocity) noexcept;
+    void releaseVoice(int voice) noexcept;
+    int findVoiceToSteal() const noexcept;
+    bool isBlockActive(int block) const noexcept;
+    void advanceGlide(int voice, int numSamples) noexcept;
+    void updateKernelRatios(int block) noexcept;
+    void renderUnison(int voice, const WavetableOscillator::TableSet& tables, const float* pitchMod,
+                      int numSamples, float* kernelOutput, float* sumL, float* sumR) noexcept;
+    inline float nextEnvelopeSample(int voice) noexcept;
+    static bool filterStatesConverged(simd::FloatReg ic1, simd::FloatReg ic2,
+                                      simd::FloatReg ic1R, simd::FloatReg ic2R) noexcept;
+    void applyDrive(int block, Oversampler::ChannelState& state, float* signal,
+                    const float* drive, int numSamples, float* oversampled) noexcept;
+    void renderBlock(int block, const WavetableOscillator::TableSet& tables,
+                     const ChunkControls& controls, int numSamples) noexcept;
+    void runTask(int taskIndex) noexcept override;
+
+    static float midiNoteToFreq(int midiNote) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VoiceEngine)
+};
@@ -0,0 +1,159 @@
+#include "WavetableOscillator.h"
+#include <cmath>
+
+WavetableOscillator::WavetableOscillator()
+    : spectrum((size_t)tableSize),
+      scratch((size_t)tableSize)
+{
+    rebuildTables();
+    hasTables = true;
+}
+
+void WavetableOscillator::setShape(const Shape& newShape)
+{
+    if (hasTables && newShape == currentShape)
+        return;
+
+    currentShape = newShape;
+    rebuildTables();
+    hasTables = true;
+}
+
+const WavetableOscillator::TableSet& WavetableOscillator::acquireTables() noexcept
+{
+    tableBuffers.acquire();
+    return tableBuffers.getReadBuffer();
+}
+
+float WavetableOscillator::renderShapeSample(float ph, const Shape& shape) noexcept
+{
+    // ===== Fractal Oscillator Core =====
+    // Keeps the 4-shape morph, then layers a small number of sine partials
+    // whose behaviour is driven by:
+    //   chaos  -> number of partials / irregularity
+    //   spread -> even/odd bias (tone colour)
+    // The per-partial LFO wobble is frozen at the LFO's rest phase, since the
+    // tables are rebuilt on parameter changes rather than per sample.
+    //
+    // The partials, their wobble and their rolloff are all stepped by
+    // recurrence, so each extra partial costs a handful of multiplies and the
+    // cap can go up to maxPartialLimit.
+
+    const float m = juce::jlimit(0.0f, 1.0f, shape.morph);
+    const float seg = 1.0f / 3.0f;
+
+    // --- Base waves (naive; band-limiting happens per mip level) ---
+    const float sineSample = std::sin(ph);
+    const float triSample = (2.0f / juce::MathConstants<float>::pi) * std::asin(sineSample);
+
+    const float t = ph / juce::MathConstants<float>::twoPi;
+    const float sawSample = 2.0f * t - 1.0f;
+    const float squareSample = std::tanh((t < 0.5f ? 1.0f : -1.0f) * 1.15f);
+
+    // Smooth morph across four shapes
+    float base;
+    if (m < seg)            base = juce::jmap(m / seg,                 sineSample,  triSample);
+    else if (m < 2.0f*seg)  base = juce::jmap((m - seg) / seg,         triSample,   sawSample);
+    else                    base = juce::jmap((m - 2.0f*seg) / seg,    sawSample,   squareSample);
+
+    // --- Fractal layering ---
+    const float chaos  = juce::jlimit(0.0f, 1.0f, shape.chaos);
+    const float spread = juce::jlimit(0.0f, 1.0f, shape.spread);
+
+    // Number of partials grows with chaos (1..maxPartials)
+    const int cap = juce::jlimit(1, maxPartialLimit, shape.maxPartials);
+    const int partials = juce::jlimit(1, cap, 1 + (int)std::round(chaos * (float)(cap - 1)));
+
+    // Amplitude rolloff (steeper at low chaos)
+    const float rolloff = juce::jmap(chaos, 0.0f, 1.0f, 0.75f, 0.45f);
+
+    // Even/odd emphasis via spread
+    const float evenBias = juce::jlimit(0.0f, 1.0f, spread * 0.85f);
+    const float oddBias  = juce::jlimit(0.0f, 1.0f, 1.0f - spread * 0.65f);
+
+    const float evenWeight = juce::jlimit(0.0f, 1.0f, 0.6f + 0.4f * evenBias);
+    const float oddWeight = juce::jlimit(0.0f, 1.0f, 0.6f + 0.4f * oddBias);
+
+    // Chebyshev recurrences: sin((k + 1)x) = 2 cos(x) sin(kx) - sin((k - 1)x).
+    // Stepped in double so 64 partials don't accumulate float error.
+    const double phaseTwoCos = 2.0 * std::cos((double)ph);
+    double harmonic = std::sin((double)ph);          // sin(k * ph), k = 1
+    double harmonicPrev = 0.0;
+
+    constexpr double wobbleStep = 0.37;
+    const double wobbleTwoCos = 2.0 * std::cos(wobbleStep);
+    double wobbleSin = std::sin(wobbleStep);         // sin(k * 0.37), k = 1
+    double wobbleSinPrev = 0.0;
+
+    float rolloffWeight = 1.0f;                      // rolloff^(k - 1)
+
+    float layered = base;
+    float norm = 1.0f;
+
+    for (int k = 2; k <= partials + 1; ++k)
+    {
+        const double nextHarmonic = phaseTwoCos * harmonic - harmonicPrev;
+        harmonicPrev = harmonic;
+        harmonic = nextHarmonic;
+
+        const double nextWobble = wobbleTwoCos * wobbleSin - wobbleSinPrev;
+        wobbleSinPrev = wobbleSin;
+        wobbleSin = nextWobble;
+
+        rolloffWeight *= rolloff;
+
+        const float wobble = 1.0f + 0.12f * chaos * (float)wobbleSin;
+        const float w = rolloffWeight * ((k % 2 == 0) ? evenWeight : oddWeight) * wobble;
+
+        layered += w * (float)harmonic;
+        norm += w;
+    }
+
+    // Normalise and blend with original; layerMix scales with chaos
+    layered = juce::jlimit(-1.5f, 1.5f, layered / juce::jmax(1.0f, norm));
+    const float layerMix = juce::jlimit(0.0f, 1.0f, juce::jmap(chaos, 0.0f, 1.0f, 0.0f, 0.85f));
+
+    const float out = juce::jmap(layerMix, base, layered);
+
+    // Final tiny soft clip to keep headroom consistent
+    return std::tanh(out * 1.1f);
+}
+
+void WavetableOscillator::rebuildTables()
+{
+    // Render one naive cycle and take its spectrum...
+    for (int n = 0; n < tableSize; ++n)
+    {
+        const float ph = juce::MathConstants<float>::twoPi * (float)n / (float)tableSize;
+        spectrum[(size_t)n] = { renderShapeSample(ph, currentShape), 0.0f };
+    }
+
+    fft.perform(spectrum.data(), false);
+
+    // ...then resynthesise each octave with only the harmonics it can carry.
+    auto& tables = tableBuffers.getWriteBuffer();
+
+    for (int level = 0; level < numMipLevels; ++level)
+    {
+        const int maxHarmonic = juce::jmin(tableSize / 2 - 1, (tableSize / 2) >> level);
+
+        std::fill(scratch.begin(), scratch.end(), std::complex<float>());
+        scratch[0] = spectrum[0];
+
+        for (int k = 1; k <= maxHarmonic; ++k)
+        {
+            scratch[(size_t)k] = spectrum[(size_t)k];
+            scratch[(size_t)(tableSize - k)] = spectrum[(size_t)(tableSize - k)];
+        }
+
+        fft.perform(scratch.data(), true);
+
+        auto& samples = tables[(size_t)level].samples;
+        for (int n = 0; n < tableSize; ++n)
+            samples[(size_t)n] = scratch[(size_t)n].real();
+
+        samples[(size_t)tableSize] = samples[0];
+    }
+
+    tableBuffers.publish();
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <complex>
+#include <cstring>
+#include <vector>
+#include "SimpleFft.h"
+#include "TripleBuffer.h"
+#include "PhaseAccumulator.h"
+
+// Band-limited, mip-mapped wavetable bank for the morphing oscillator.
+//
+// The sine -> tri -> saw -> square morph and the fractal partial layering are
+// rendered once per shape change (waveMorph / chaosAmount / subMixAmount) into
+// one single-cycle table per octave. The audio thread then only picks a mip
+// level from the phase increment and linearly interpolates the table.
+class WavetableOscillator
+{
+public:
+    static constexpr int tableBits = 11;
+    static constexpr int tableSize = 1 << tableBits;   // 2048 samples per cycle
+    static constexpr int numMipLevels = tableBits;     // level L keeps harmonics up to (tableSize / 2) >> L
+
+    struct Table
+    {
+        std::array<float, tableSize + 1> samples {};   // +1 guard point for interpolation
+    };
+
+    using TableSet = std::array<Table, numMipLevels>;
+
+    static constexpr int maxPartialLimit = 64;
+    static constexpr int defaultMaxPartials = 6;
+
+    struct Shape
+    {
+        float morph = 0.0f;
+        float chaos = 0.0f;
+        float spread = 0.0f;
+        int maxPartials = defaultMaxPartials;    // fractal layers at full chaos, 1..maxPartialLimit
+
+        bool operator== (const Shape& other) const noexcept
+        {
+            return morph == other.morph && chaos == other.chaos && spread == other.spread
+                && maxPartials == other.maxPartials;
+        }
+    };
+
+    WavetableOscillator();
+
+    // Message thread: re-renders the table set if the shape changed.
+    void setShape(const Shape& newShape);
+
+    // Audio thread: call once per block and render the block from the returned set.
+    const TableSet& acquireTables() noexcept;
+
+    // Highest mip level whose harmonics all stay below Nyquist for this increment.
+    static inline int getMipLevel(float normPhaseInc) noexcept
+    {
+        // floor(log2(tableSize * inc)) straight from the float exponent; +1 rounds up.
+        const float scaled = normPhaseInc * (float)tableSize;
+        std::uint32_t bits;
+        std::memcpy(&bits, &scaled, sizeof(bits));
+        const int octave = (int)((bits >> 23) & 0xffu) - 127 + 1;
+        return juce::jlimit(0, numMipLevels - 1, octave);
+    }
+
+    // Top bits of the fixed-point phase index the table, the rest interpolate.
+    static constexpr int fractionBits = 32 - tableBits;
+    static constexpr juce::uint32 fractionMask = (1u << fractionBits) - 1u;
+    static constexpr float fractionScale = 1.0f / (float)(1u << fractionBits);
+
+    // phase: 32-bit fixed-point cycle position, normPhaseInc in cycles per sample.
+    static inline float lookup(const TableSet& tables, juce::uint32 phase, float normPhaseInc) noexcept
+    {
+        const auto& table = tables[(size_t)getMipLevel(normPhaseInc)].samples;
+        const auto index = (size_t)(phase >> fractionBits);
+        const float frac = (float)(juce::int32)(phase & fractionMask) * fractionScale;
+        return table[index] + frac * (table[index + 1] - table[index]);
+    }
+
+    // Full-band (naive) morph shape, ph in [0, 2pi). Only used to build tables.
+    static float renderShapeSample(float ph, const Shape& shape) noexcept;
+
+private:
+    void rebuildTables();
+
+    Shape currentShape;
+    bool hasTables = false;
+
+    SimpleFft fft { tableBits };
+    std::vector<std::complex<float>> spectrum;
+    std::vector<std::complex<float>> scratch;
+
+    TripleBuffer<TableSet> tableBuffers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WavetableOscillator)
+};